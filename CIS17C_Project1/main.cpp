@@ -50,18 +50,66 @@
 #include <ctime>     // Time-based functions
 #include <array>     // Fixed-size array container
 #include <string>    // String handling
+#include <string_view> // Borrowed views of Word letters
 #include <cstring>   // C-style string functions
 #include <algorithm> // Algorithms
 #include <limits>    // Numeric limits
 #include <chrono>    // For high-precision time handling
 #include <thread>    // For sleep functionality
+#include <vector>    // Dynamic arrays for lookup indexes
+#include <cstdint>   // Fixed-width integer types
+#include <cmath>     // Math functions
+#include <future>    // Background hint planning
+#include <unordered_map> // Visited sets for graph searches
+#include <random>    // Per-thread random generators
+#include <tuple>     // Sort keys with several fields
+#include <unordered_set> // Dead-end memo for phrase searches
+#include <mutex>     // Shared results between search threads
+#include <atomic>    // Stop flags shared between threads
+#include <functional> // Line visitors for the dictionary linter
+#include <sstream>   // Index images built in memory
+#include <new>       // Counting allocator for --bench builds
+
+// SIMD intrinsics for the letter-histogram kernels on x86
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define UNSCRAMBLE_X86_SIMD 1
+#endif
+
+// Memory-mapped files where the platform has mmap
+#if defined(__unix__) || defined(__APPLE__) || defined(__CYGWIN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define UNSCRAMBLE_POSIX_MMAP 1
+#endif
+
+// File change notifications for hot dictionary reload on Linux
+#if defined(__linux__)
+#include <sys/inotify.h>
+#define UNSCRAMBLE_INOTIFY 1
+#endif
+
+// Default dictionary compiled into the program, once --embed has
+// generated the header next to this file
+#if defined(__has_include)
+#if __has_include("default_dictionary.h")
+#include "default_dictionary.h"
+#define UNSCRAMBLE_EMBEDDED_DICTIONARY 1
+#endif
+#endif
+
+// Heap allocation counts in --bench come from a build made with
+// -DUNSCRAMBLE_COUNT_ALLOCATIONS, which replaces the global operator new
+// and delete; the game itself keeps the standard allocator
 
 // Use standard namespace
 // This will save lots of typing times
 using namespace std;
 
 // Constants for game settings
-const size_t maxWords = 200;   // Max words storage
+const size_t maxWords = 50000000; // Max words storage (IDs are 32-bit)
 const int easyMinLength = 3;   // Min length for easy
 const int easyMaxLength = 5;   // Max length for easy
 const int mediumMinLength = 6; // Min length for medium
@@ -70,684 +118,8898 @@ const int hardMinLength = 9;   // Min length for hard
 const int hintCost = 1;        // Points per hint
 const int maxHintsPerWord = 2; // Max hints per word
 
-// Function Prototypes
-void displayIntro();                                                                                                                                                 // Show game intro
-void displayRules();                                                                                                                                                 // Show game rules
-void displayMenu(int score, int highestScore);                                                                                                                       // Show main menu
-void displayDifficultyMenu();                                                                                                                                        // Show difficulty menu
-int getDifficultyChoice();                                                                                                                                           // Get difficulty choice
-bool isEasyWord(const string &word);                                                                                                                                 // Check if word is easy
-bool isMediumWord(const string &word);                                                                                                                               // Check if word is medium
-bool isHardWord(const string &word);                                                                                                                                 // Check if word is hard
-void filterWordsByDifficulty(array<string, maxWords> &filteredWords, const array<string, maxWords> &words, size_t wordCount, int difficulty, size_t &filteredCount); // Filter words
-void playGame(int &score, int &highestScore, int &streak, int &maxStreak, array<string, maxWords> &words, size_t wordCount, int difficulty);                         // Play game
-void displayShop(array<string, maxWords> &words, size_t &wordCount);                                                                                                 // Show shop
-size_t loadWords(const string &filename, array<string, maxWords> &words, size_t startIndex = 0);                                                                     // Load words
-string scrambleWord(const string &word);                                                                                                                             // Scramble word
-void handleGameOver(int &score, const string &correctWord);                                                                                                          // Handle game over
-void updateScore(bool isCorrect, int &score, int &highestScore, int points);                                                                                         // Update scores
-void displayHintMenu();                                                                                                                                              // Show hint menu
-void useHint(const string &word, int &hintsUsed, int &score);                                                                                                        // Use hint
-void displayAchievements();                                                                                                                                          // Show achievements
-void updateAchievements(bool wonGame, int score, int hintsUsed, int timeTaken);                                                                                      // Update achievements
-void playGame();                                                                                                                                                     // Game round placeholder
+// Bloom filter settings
+const double bloomFalsePositiveRate = 0.01; // Chance a non-word passes the filter
+const size_t bloomBlockBits = 512;          // Bits per block (one cache line)
 
-// Define the number of achievements
-const int numAchievements = 4;
+// Perfect hash settings
+const double perfectHashGamma = 2.0;            // Bits per remaining key at each level
+const size_t rankBlockBits = 512;               // Bits covered by each rank sample
+const uint32_t noWordId = 0xFFFFFFFFu;          // ID returned for unknown words
 
-// Define Achievement struct
-struct Achievement
+// Define BloomFilter struct
+// Blocked Bloom filter: all bits of a key live in one 64-byte block,
+// so rejecting a non-word touches a single cache line
+struct BloomFilter
 {
-    // Achievement name
-    string name;
+    // Filter bits, eight 64-bit words per block
+    vector<uint64_t> bits;
 
-    // Achievement description
-    string description;
+    // Number of blocks
+    size_t blockCount = 0;
 
-    // Achievement status
-    bool achieved;
+    // Bits set per key
+    int probes = 0;
 
-    // Default constructor
-    Achievement() : name(""), description(""), achieved(false) {}
+    // Keys the filter was sized for
+    size_t capacity = 0;
+};
 
-    // Constructor with parameters
-    Achievement(string n, string d) : name(n), description(d), achieved(false) {}
+// Word ladder settings
+const int ladderMinSteps = 3;     // Shortest ladder offered
+const int ladderMaxSteps = 6;     // Longest ladder offered
+const int ladderExtraMoves = 3;   // Moves allowed beyond the shortest ladder
+const int ladderAttempts = 200;   // Start words tried per puzzle
+
+// Letter grid settings
+const size_t gridSize = 5;                   // Rows and columns
+const size_t gridCells = gridSize * gridSize; // Letters in the grid
+const size_t gridMinWordLength = 3;          // Shortest word that counts
+const int gridCandidates = 4000;             // Grids tried per puzzle
+
+// Spelling bee settings
+const int beeLetters = 7;             // Letters in a puzzle
+const size_t beeMinWordLength = 4;    // Shortest word that counts
+const int beeTargetAnswers = 25;      // Preferred number of answers
+const int beeAnswerTolerance = 10;    // Accepted distance from the target
+const int beePangramBonus = 7;        // Extra points for using every letter
+
+// Wordle settings
+const int wordleMaxGuesses = 6;                   // Guesses per puzzle
+const size_t wordleMaxWords = 4096;               // Words per length in the pattern matrix
+const uint64_t wordleSampleSeed = 0x574f52444c45ULL; // Fixed seed spreading a pool over its length
+const uint32_t wordleCacheMagic = 0x31444C57u;    // "WLD1" at the start of a pattern cache
+
+// Evil hangman settings
+const size_t hangmanMinLength = 4;      // Shortest word length played
+const size_t hangmanMaxLength = 12;     // Longest word length played
+const size_t hangmanMinCandidates = 20; // Words a length needs to be played
+const int hangmanLives = 8;             // Wrong letters allowed
+
+// Crossword pattern settings
+const size_t patternMaxLength = 24;    // Longest word length indexed
+const size_t blanksMinLength = 5;      // Shortest word in fill the blanks
+const size_t blanksMaxLength = 8;      // Longest word in fill the blanks
+const size_t blanksMaxAnswers = 40;    // Most words a pattern may fit
+const int blanksAttempts = 200;        // Words tried per puzzle
+
+// Phrase anagram settings
+const size_t phraseMinWordLength = 2;  // Shortest word used in a phrase
+const size_t phraseMaxWords = 4;       // Most words in a phrase
+const size_t phraseMaxResults = 5;     // Phrases listed after a jumble
+const int phraseTimeLimitMs = 1000;    // Search time for the listed phrases
+const int phraseHintTimeMs = 300;      // Search time for a hint
+const size_t jumbleMinLength = 4;      // Shortest word in a jumble
+const size_t jumbleMaxLength = 6;      // Longest word in a jumble
+
+// Daily challenge settings
+const char calendarFile[] = "calendar.dat";     // Precomputed daily puzzles
+const uint32_t calendarMagic = 0x324C4143u;     // "CAL2" at the start of a calendar
+const size_t calendarMaxLength = 24;            // Longest word a daily puzzle can use
+const size_t calendarHints = 2;                 // Letter hints stored per puzzle
+const int calendarScrambleTries = 20;           // Shuffles tried before a word is skipped
+const size_t calendarDrawsPerWord = 4;          // Draws per pool word before a day gives up on the pool
+
+// Adaptive difficulty settings
+const double adaptiveTargetSolveRate = 0.7;  // Chance of solving the player should get
+const double adaptiveSkillStart = 6.0;       // Word length a new player solves half the time
+const double adaptiveLengthScale = 1.5;      // Letters per step of the solve-chance curve
+const double adaptiveLearningRate = 0.8;     // How far one round moves the skill
+const float adaptiveSolvedFactor = 0.25f;    // Weight kept by a solved word
+const float adaptiveMissedFactor = 2.0f;     // Weight growth of a missed word
+const float adaptiveMaxWeight = 16.0f;       // Cap on any word's weight
+
+// Review schedule settings
+const uint32_t reviewFirstInterval = 2;  // Rounds before a missed word comes back
+const double reviewGrowthFactor = 2.5;   // Interval growth after each solved review
+const uint32_t reviewMaxInterval = 64;   // Words spaced further apart are retired
+const size_t reviewHeapArity = 4;        // Children per node of the review heap
+
+// Rating settings
+const double eloBaseRating = 1500.0;  // Rating of a word of eloBaseLength letters
+const double eloBaseLength = 7.0;     // Word length rated eloBaseRating to start
+const double eloPerLetter = 100.0;    // Starting rating step per letter
+const double eloPlayerK = 32.0;       // Largest player rating change per round
+const double eloWordK = 16.0;         // Largest word rating change per round
+
+// Corpus ingestion settings
+const size_t ingestMinLength = 2;            // Shortest token counted
+const size_t ingestMaxLength = 24;           // Longest token counted
+const uint64_t ingestMinCount = 2;           // Fewest sightings for a word to be kept
+const size_t ingestShards = 64;              // Independently locked slices of the counts
+const size_t ingestLocalSlots = 1 << 20;     // Slots in each thread's local count table
+const size_t ingestSketchDepth = 4;          // Count-min sketch rows (bounded mode)
+const size_t ingestHeavyHitters = 200000;    // Words kept per thread; the table holds twice this
+
+// Frequency tier settings
+const char frequencyFile[] = "dictionary.freq"; // Frequency table for dictionary.txt
+const uint32_t frequencyMagic = 0x31515246u;    // "FRQ1" at the start of a frequency table
+const double tierWeightFrequency = 0.4;         // Default weight of how rare a word is
+const double tierWeightLength = 0.3;            // Default weight of word length
+const double tierWeightRarity = 0.2;            // Default weight of uncommon letters
+const double tierWeightAmbiguity = 0.1;         // Default weight of having no anagrams
+
+// Dictionary lint settings
+const size_t lintMaxLength = 24;          // Longest word a dictionary line should hold
+const size_t lintMinPart = 3;             // Shortest word counted as half of a glued pair
+const size_t lintExamples = 10;           // Problems described in a report
+const size_t lintBufferBytes = 1 << 20;   // Bytes read from the file at a time
+
+// Word pack settings
+const size_t packBloomHeadroom = 2; // Bloom filter capacity, as a multiple of the words, when a pack outgrows it
+const char packCacheDir[] = "packs";                // Binary packs, each named by its content hash
+const char packCatalogFile[] = "packs/catalog.txt"; // Packs the shop offers
+const uint32_t packMagic = 0x314B4150u;             // "PAK1" at the start of a binary pack
+
+// Hot reload settings
+const int reloadSettleMs = 200; // Quiet time after a dictionary change before rebuilding
+
+// Index image settings
+const char indexImageFile[] = "dictionary.idx"; // Saved indexes for dictionary.txt
+const uint32_t indexImageMagic = 0x31584449u;   // "IDX1" at the start of an index image
+const uint32_t indexImageVersion = 3;           // Layout of the header and sections
+const size_t indexImageAlign = 64;              // Byte alignment of every array in the image
+
+// Word value settings
+const size_t wordInlineLetters = 22; // Letters a Word holds without the arena
+
+// Word store backends
+enum class WordBackend
+{
+    Strings, // One string per word, fastest access
+    Succinct // LOUDS trie, a few bytes per word
 };
 
-// Array of achievements with a fixed size
-array<Achievement, numAchievements> achievements = {
-    // First Achievement
-    Achievement("First Win", "Win your first game"),
-    // Second Achievement
-    Achievement("Hint Master", "Win without using a hint"),
-    // Third Achievement
-    Achievement("High Scorer", "Reach a score of 50 or more"),
-    // Fourth Achievement
-    Achievement("Quick Thinker", "Win within 30 seconds")};
+// Backend used for the game's word store, chosen with --backend
+WordBackend wordBackend = WordBackend::Strings;
 
-// Main function where the program starts execution
-int main()
+// Marker for a missing trie node
+const size_t noNode = static_cast<size_t>(-1);
+
+// Define LetterHistogram struct
+// Letter counts of a word: buckets 0-25 for a-z, bucket 26 for
+// anything else, padded to 32 bytes so one AVX2 register holds it
+struct alignas(32) LetterHistogram
 {
-    // Seed the random number generator
-    srand(static_cast<unsigned int>(time(0)));
+    // Count per bucket
+    uint8_t counts[32];
+};
 
-    // Initialize player's score
-    int score = 0;
+// Define HintPlan struct
+// Order in which letter hints reveal positions of the round's word
+struct HintPlan
+{
+    // Positions, most helpful first
+    vector<size_t> order;
 
-    // Initialize highest score variable
-    int highestScore = 0;
+    // Positions already shown to the player
+    uint64_t revealed = 0;
+};
 
-    // Current streak of consecutive correct guesses
-    int streak = 0;
+// Define PerfectHash struct
+// Minimal perfect hash in the BBHash style: each level is a bit array
+// where keys that landed alone keep their bit and colliding keys fall
+// through to the next, smaller level. A key's slot is the rank of its
+// bit, so slots are dense in 0..n-1 and the table costs about 3-4 bits per key
+struct PerfectHash
+{
+    // All level bit arrays, one after another
+    vector<uint64_t> bits;
 
-    // Highest streak reached
-    int maxStreak = 0;
+    // Bit offset where each level starts
+    vector<uint64_t> levelOffsets;
 
-    // Display game intro
-    displayIntro();
+    // Set bits before each 512-bit block, for constant-time rank
+    vector<uint32_t> rankSamples;
 
-    // Display game rules
-    displayRules();
+    // Number of keys hashed
+    size_t keyCount = 0;
+};
 
-    // Wait for the user to press enter
-    cin.get();
+// Define LoudsTrie struct
+// Succinct trie in level-order unary degree sequence (LOUDS) form.
+// Nodes are numbered breadth-first and each node writes a 1 bit per
+// child followed by a 0, so the shape costs about two bits per node
+// and a node's children always have consecutive numbers
+struct LoudsTrie
+{
+    // Degree sequence bits, starting with the "10" super-root
+    vector<uint64_t> shape;
 
-    // Array to store words from the file
-    array<string, maxWords> words;
+    // Set bits before each 512-bit block of shape
+    vector<uint32_t> shapeRanks;
 
-    // Load initial words
-    size_t wordCount = loadWords("dictionary.txt", words);
+    // Edge letter leading into each node
+    vector<char> labels;
 
-    // Variable to track if the game should exit
-    bool exitGame = false;
+    // One bit per node marking the end of a word
+    vector<uint64_t> terminal;
 
-    // Main game loop
-    while (!exitGame)
-    {
-        // Display Achievements
-        playGame();
+    // Set bits before each 512-bit block of terminal
+    vector<uint32_t> terminalRanks;
 
-        // Display game menu with score
-        displayMenu(score, highestScore);
+    // Number of nodes
+    size_t nodeCount = 0;
+};
 
-        // Variable to store the menu option selected
-        int option;
+// Define WordStore struct
+// Every loaded word, addressed by its ID (load order; the Succinct
+// backend sorts each batch of words it is given)
+struct WordStore
+{
+    // Backend holding the letters
+    WordBackend backend = WordBackend::Strings;
 
-        // Prompt on what user should input
-        cout << "Enter your selection: ";
+    // Words by ID (Strings backend)
+    vector<string> strings;
 
-        // Validate input
-        while (!(cin >> option))
-        {
-            // Clear the error flag on cin
-            cin.clear();
+    // Tries holding the letters, one per append (Succinct backend). A
+    // trie's words take consecutive IDs in its sorted order, so a word's
+    // ID is its trie's first ID plus the rank of its terminal node
+    vector<LoudsTrie> tries;
 
-            // Ignore the rest of the line
-            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    // First word ID of each trie (Succinct backend)
+    vector<uint32_t> trieStarts;
 
-            // Prompt user to enter a number
-            cout << "Invalid selection. Please enter a number: ";
-        }
+    // Length of every word, so filters never touch the letters
+    vector<uint8_t> lengths;
+};
 
-        // Process menu option
-        switch (option)
-        {
-        // Start a new game
-        case 1:
-        {
-            // Get difficulty choice from the player
-            int difficulty = getDifficultyChoice();
+// Define LadderIndex struct
+// Wildcard buckets for word ladders: "cat" sits in the buckets for
+// "?at", "c?t" and "ca?", and words sharing a bucket are one letter
+// apart. Stored as sorted arrays (bucket key, then word IDs)
+struct LadderIndex
+{
+    // Distinct bucket keys in ascending order
+    vector<uint64_t> keys;
 
-            // Start the game with chosen difficulty
-            playGame(score, highestScore, streak, maxStreak, words, wordCount, difficulty);
+    // Start of each bucket in wordIds, plus an end marker
+    vector<uint32_t> starts;
 
-            // Break out of switch case
-            break;
-        }
+    // Word IDs grouped by bucket
+    vector<uint32_t> wordIds;
+};
 
-        // Display the shop
-        case 2:
-            // displayShop Function will run
-            displayShop(words, wordCount);
+// Define GridTrie struct
+// Trie used to solve letter grids. Each node keeps a 26-bit mask of
+// its child letters and the index of its first child; children are
+// stored together, so a child is found with a single popcount
+struct GridTrie
+{
+    // Child letters of each node
+    vector<uint32_t> childMasks;
 
-            // Break out of switch case
-            break;
+    // Index of each node's first child
+    vector<uint32_t> firstChild;
 
-        // Exit the game
-        case 3:
-            // exitGame will be true
-            exitGame = true;
+    // Word ending at each node, or noWordId
+    vector<uint32_t> wordIds;
+};
 
-            // Prompt user that game is exiting
-            cout << "Exiting the game.\n";
+// Define GridSearch struct
+// Scratch space for one thread solving grids
+struct GridSearch
+{
+    // Letters of the grid being solved, row by row
+    string grid;
 
-            // Break out of switch case
-            break;
+    // Solve number that last found each trie node's word
+    vector<uint32_t> stamps;
 
-        // Handle invalid selection
-        default:
+    // Current solve number
+    uint32_t stamp = 0;
 
-            // Prompt user to enter a number 1-3
-            cout << "Invalid selection. Please enter a number between 1 and 3.\n";
+    // Word IDs found in the current grid
+    vector<uint32_t> found;
+};
 
-            // Break out of switch case
-            break;
-        }
-    }
+// Define BeeIndex struct
+// Words grouped by their set of letters (a 26-bit mask), so every word
+// made only from some letters is found by looking up submasks
+struct BeeIndex
+{
+    // Distinct letter masks in ascending order
+    vector<uint32_t> masks;
 
-    // End program
-    return 0;
-}
+    // Start of each mask's group in wordIds, plus an end marker
+    vector<uint32_t> starts;
 
-// Function to display introductory text for the game
-void displayIntro()
+    // Word IDs grouped by mask
+    vector<uint32_t> wordIds;
+};
+
+// Define BeePuzzle struct
+// One spelling bee: seven letters, one of which every word must use
+struct BeePuzzle
 {
-    cout << "\n\n";
-    cout << "****************************************\n";
-    cout << "*              UNSCRAMBLE              *\n";
-    cout << "****************************************\n";
-    cout << "* Hello Welcome to my Unscramble game! *\n";
-    cout << "* This program is a word unscrambling  *\n";
-    cout << "* game where players are presented with*\n";
-    cout << "* scrambled words and must guess the   *\n";
-    cout << "* correct word. The game includes      *\n";
-    cout << "* various difficulty levels, achieveme *\n";
-    cout << "* nts, hints, scoring with combo points*\n";
-    cout << "* and a shop for additional words.     *\n";
-    cout << "* Created by \"Vannara Thong\"         *\n";
-    cout << "****************************************\n";
-}
+    // All seven letters
+    uint32_t letters = 0;
 
-// Function to display the rules of the game
-// This provides players with instructions on how to play and what to expect
-void displayRules()
+    // The required letter (a single bit)
+    uint32_t center = 0;
+
+    // Number of valid words
+    int answerCount = 0;
+};
+
+// Define MappedFile struct
+// A read-only file mapped into memory. Where mmap is missing the file
+// is read into buffer instead, so callers only see data and size
+struct MappedFile
 {
-    cout << "****************************************\n";
-    cout << "*                 RULES                *\n";
-    cout << "****************************************\n";
-    cout << "* You'll be given a word to unscramble *\n";
-    cout << "* and must solve it within 3 tries.    *\n";
-    cout << "* Points are awarded based on word     *\n";
-    cout << "* length and difficulty level chosen.  *\n";
-    cout << "* If the word is guessed incorrectly a *\n";
-    cout << "* point will be taken from your score. *\n";
-    cout << "****************************************\n";
-    cout << "Press \"Enter\" to continue.\n";
-}
+    // First byte of the file, or nullptr when nothing is open
+    const uint8_t *data = nullptr;
 
-// Function to display the main menu with the current score and highest score
-// Shows the player their progress and offers options to play, shop, or exit
-void displayMenu(int score, int highestScore)
+    // Length in bytes
+    size_t size = 0;
+
+    // True when data came from mmap and must be unmapped
+    bool mapped = false;
+
+    // File contents when mmap is unavailable
+    vector<uint8_t> buffer;
+};
+
+// Define WordleCacheHeader struct
+// Start of a pattern cache file; the matrix follows right after
+struct WordleCacheHeader
 {
-    cout << "\n****************************************\n";
-    cout << "* Current Score: " << score << setw(23) << "*\n";
-    cout << "* Highest Score: " << highestScore << setw(23) << "*\n";
-    cout << "****************************************\n";
-    cout << "Choose an option from the menu\n";
-    cout << "1. Play the game\n";
-    cout << "2. Shop\n";
-    cout << "3. Exit the game\n";
-    // cout << "Enter your selection: ";
-}
+    // Always wordleCacheMagic
+    uint32_t magic;
 
-// Function to display the difficulty menu for the player
-// Provides the player with difficulty level options before starting a game
-void displayDifficultyMenu()
+    // Word length of the table
+    uint32_t length;
+
+    // Words in the pool (the matrix is count x count)
+    uint32_t count;
+
+    // Keeps the fingerprint 8-byte aligned
+    uint32_t padding;
+
+    // Hash of the pool words, so a changed dictionary rebuilds the cache
+    uint64_t fingerprint;
+};
+
+// Define WordleTable struct
+// Feedback pattern of every (guess, answer) pair for one word length.
+// A pattern is a base-3 number with one digit per letter: 0 gray,
+// 1 yellow, 2 green. Row g holds guess g against every answer
+struct WordleTable
 {
-    cout << "\nSelect Difficulty Level:\n";
-    cout << "1. Easy (3-5 letters)\n";
-    cout << "2. Medium (6-8 letters)\n";
-    cout << "3. Hard (9+ letters)\n";
-    cout << "Enter your choice: ";
-}
+    // Word length, or 0 before the table is built
+    size_t length = 0;
 
-// Function to retrieve the difficulty choice from the player
-// Prompts the player to select a difficulty level and returns their choice
-int getDifficultyChoice()
+    // Word IDs of the pool, ascending; guesses and answers alike
+    vector<uint32_t> wordIds;
+
+    // Letters of each pool word packed one per byte
+    vector<uint64_t> packed;
+
+    // Pattern matrix, count x count
+    const uint16_t *patterns = nullptr;
+
+    // Cache file the matrix is mapped from
+    MappedFile cache;
+
+    // Matrix computed this run when the cache could not be mapped
+    vector<uint16_t> computed;
+};
+
+// Define HangmanBucket struct
+// Every distinct lowercase word of one length, stored flat. Entry k's
+// letters are packed one per byte into letters[2k] (first eight) and
+// letters[2k + 1] (the rest). Rounds only pass around entry indexes
+struct HangmanBucket
+{
+    // Word ID of each entry
+    vector<uint32_t> wordIds;
+
+    // Packed letters, two 64-bit words per entry
+    vector<uint64_t> letters;
+};
+
+// Define PatternBucket struct
+// Positional bitsets for the words of one length: bit k of the set for
+// (position, letter) is on when entry k has that letter there. A
+// pattern like "a?p?e" is the AND of the sets for its known letters
+struct PatternBucket
+{
+    // Word ID of each entry, ascending
+    vector<uint32_t> wordIds;
+
+    // 64-bit words per bitset
+    size_t blocks = 0;
+
+    // All bitsets; (position, letter) starts at (position * 26 + letter) * blocks
+    vector<uint64_t> bits;
+};
+
+// Define PhraseSearch struct
+// Shared state of one phrase anagram search. Words with the same
+// letters form one class, so the search picks classes and only
+// spells out words when it records a phrase
+struct PhraseSearch
+{
+    // Letter histogram of each class, longest words first
+    vector<LetterHistogram> classHistograms;
+
+    // Word length of each class
+    vector<size_t> classLengths;
+
+    // Distinct word IDs in each class
+    vector<vector<uint32_t>> classWords;
+
+    // Phrases found so far, as word IDs
+    vector<vector<uint32_t>> results;
+
+    // Guards results
+    mutex resultsLock;
+
+    // Most phrases wanted
+    size_t maxResults = 0;
+
+    // Time the search must end by
+    chrono::steady_clock::time_point deadline;
+
+    // Set when the search should wind down
+    atomic<bool> stop{false};
+};
+
+// Define CalendarHeader struct
+// Start of a calendar file; one CalendarPuzzle per day follows
+struct CalendarHeader
+{
+    // Always calendarMagic
+    uint32_t magic;
+
+    // Days in the file
+    uint32_t dayCount;
+
+    // First day, counted from 1970-01-01
+    int64_t firstDay;
+
+    // Seed the puzzles were generated from
+    uint64_t seed;
+
+    // Words in the dictionary the IDs refer to
+    uint64_t wordCount;
+
+    // wordListFingerprint of those words, so words added later from the
+    // shop or a reload that keeps them leave the calendar usable
+    uint64_t fingerprint;
+};
+
+// Define CalendarPuzzle struct
+// One day's puzzle, fixed size so day d is a single indexed read
+struct CalendarPuzzle
+{
+    // Word to find
+    uint32_t wordId;
+
+    // 1 easy, 2 medium, 3 hard
+    uint8_t difficulty;
+
+    // Letters in the word
+    uint8_t length;
+
+    // Most helpful positions to reveal, in order
+    uint8_t hintPositions[calendarHints];
+
+    // Scrambled letters (not the word or any other word)
+    char scramble[calendarMaxLength];
+};
+
+// Define ReviewItem struct
+// A missed word waiting to come back to the player
+struct ReviewItem
+{
+    // Round the word is due on
+    uint64_t due;
+
+    // Word to review
+    uint32_t wordId;
+
+    // Rounds between this review and the last
+    uint32_t interval;
+};
+
+// Define PlayerProfile struct
+// What the game has learned about a player. Words are laid out in
+// length order so each length is one contiguous range of a Fenwick
+// tree over the word weights; sampling a word of a given length and
+// updating one weight are both O(log N)
+struct PlayerProfile
+{
+    // Word length the player solves half the time
+    double skill = adaptiveSkillStart;
+
+    // Sampling weight of every word by ID
+    vector<float> weights;
+
+    // Fenwick tree over the weights in length order (1-based)
+    vector<double> tree;
+
+    // Rating on the same scale as the words
+    double rating = eloBaseRating;
+
+    // Rounds the player has started
+    uint64_t rounds = 0;
+
+    // Missed words waiting for review, a d-ary min-heap by due round
+    vector<ReviewItem> reviews;
+
+    // Place of each scheduled word in reviews
+    unordered_map<uint32_t, size_t> reviewSlots;
+};
+
+// Define IngestShard struct
+// One slice of the exact corpus counts with its own lock, so threads
+// merging into different shards never wait on each other
+struct IngestShard
+{
+    // Guards counts
+    mutex lock;
+
+    // Sightings of every word in this slice
+    unordered_map<string, uint64_t> counts;
+};
+
+// Define CountMinSketch struct
+// Fixed-size approximate counts: each word adds to one cell per row and
+// its estimate is the smallest of those cells, never an undercount.
+// Sketches of the same width add up cell by cell
+struct CountMinSketch
+{
+    // Cells per row (a power of two)
+    size_t width = 0;
+
+    // ingestSketchDepth rows of width cells
+    vector<uint32_t> cells;
+};
+
+// Define IngestSlot struct
+// One entry of a thread's local count table
+struct IngestSlot
+{
+    // Hash of the word
+    uint64_t hash;
+
+    // Count of the word (exact mode) or its latest estimate (bounded mode)
+    uint64_t count;
+
+    // Where the word's letters start in the worker's letters
+    uint32_t offset;
+
+    // Length of the word; 0 marks an empty slot
+    uint8_t length;
+};
+
+// Define IngestWorker struct
+// What one thread keeps while it tokenizes its part of the corpus. Its
+// local table is open-addressed with the letters in one arena, so
+// counting a token usually touches one cache line instead of map nodes
+struct IngestWorker
+{
+    // Tokens seen
+    uint64_t tokens = 0;
+
+    // Local count table
+    vector<IngestSlot> slots;
+
+    // Letters of every word in the table, back to back
+    string letters;
+
+    // Slots in use
+    size_t used = 0;
+
+    // This thread's sketch (bounded mode)
+    CountMinSketch sketch;
+
+    // Estimate a word needs to enter the table (bounded mode)
+    uint64_t threshold = 0;
+};
+
+// Define FrequencyHeader struct
+// Start of a frequency table file; one FrequencyEntry per word ID follows
+struct FrequencyHeader
+{
+    // frequencyMagic
+    uint32_t magic;
+
+    // Words in the table, the first words of the dictionary
+    uint32_t wordCount;
+
+    // Hash of those words, so a table never applies to another list
+    uint64_t fingerprint;
+
+    // Mix the tiers were built with: frequency, length, letter rarity
+    // and anagram ambiguity
+    float weights[4];
+};
+
+// Define FrequencyEntry struct
+// Corpus count and precomputed difficulty of one word
+struct FrequencyEntry
+{
+    // Sightings in the corpus (0 if unknown)
+    uint32_t count;
+
+    // Word length the word plays like under the mix
+    uint8_t ratedLength;
+
+    // Difficulty tier: 1 easy, 2 medium, 3 hard, 0 none
+    uint8_t tier;
+
+    // Keeps entries 8 bytes
+    uint16_t padding;
+};
+
+// Define LintReport struct
+// Problems found in a dictionary, by the lint tool or while loading
+struct LintReport
+{
+    // Words checked
+    uint64_t lines = 0;
+
+    // Bytes scanned
+    uint64_t bytes = 0;
+
+    // Words seen before with the same spelling
+    uint64_t duplicates = 0;
+
+    // Lines holding anything but letters
+    uint64_t nonAlphabetic = 0;
+
+    // Words seen before with other capitals
+    uint64_t caseCollisions = 0;
+
+    // Words longer than lintMaxLength
+    uint64_t overLong = 0;
+
+    // Words made of two other words, as from a missing newline
+    uint64_t concatenated = 0;
+
+    // The file does not end with a newline
+    bool missingNewline = false;
+
+    // The first few problems, described
+    vector<string> examples;
+
+    // Open-addressed table of every word seen: its lowercase hash and
+    // the hash of its first spelling (0 marks an empty slot)
+    vector<pair<uint64_t, uint64_t>> slots;
+
+    // One bit per lowercase hash, 4 bits per slot, small enough to stay
+    // in cache for the glued-word checks
+    vector<uint64_t> filter;
+
+    // Slots in use
+    size_t used = 0;
+};
+
+// Define WordPack struct
+// One word file merged into the store
+struct WordPack
+{
+    // File the words came from
+    string filename;
+
+    // Hash of the pack's distinct words, whatever their order
+    uint64_t contentHash = 0;
+
+    // First word ID the pack added
+    uint32_t firstId = 0;
+
+    // Words the pack added
+    uint32_t wordCount = 0;
+};
+
+// Define PackHeader struct
+// Start of a binary word pack. The header is followed by wordCount + 1
+// letter offsets (uint32_t) and then every word's letters back to back,
+// so a word is two offset reads and a slice of the mapped file
+struct PackHeader
+{
+    // Always packMagic
+    uint32_t magic;
+
+    // Words in the pack
+    uint32_t wordCount;
+
+    // Content hash the file is named by
+    uint64_t contentHash;
+
+    // Bytes of letters after the offsets
+    uint64_t letterBytes;
+};
+
+// Define CatalogPack struct
+// One word pack the shop offers; a line of the catalog file
+struct CatalogPack
+{
+    // Content hash, which names the pack's file in the cache
+    uint64_t contentHash = 0;
+
+    // Words in the pack
+    uint32_t wordCount = 0;
+
+    // Language code, like "en"
+    string language;
+
+    // Theme, like "animals" or "general"
+    string theme;
+
+    // easy, medium or hard
+    string difficulty;
+};
+
+// Define Word struct
+// One game word held by value in 24 bytes: up to wordInlineLetters
+// letters inline, zero padded, then the length. Equal inline words have
+// identical bytes, so comparing two is a fixed 24-byte compare, and
+// copying one never allocates. Longer words are rare; their letters go
+// to wordArena and the first 8 bytes hold their offset there
+struct alignas(8) Word
+{
+    // Letters, zero padded (or the arena offset of a long word)
+    char letters[wordInlineLetters];
+
+    // Letters in the word
+    uint8_t length;
+
+    // 1 when the letters live in wordArena
+    uint8_t spilled;
+};
+
+// Define IndexImageHeader struct
+// Start of an index image: every index built from one dictionary file,
+// saved so later starts copy them in instead of rebuilding them. Each
+// array is a section of raw bytes at a 64-byte aligned file offset, and
+// the table of sections sits at tableOffset, so the file holds no
+// pointers and can be mapped at any address. The arrays are not served
+// from the mapping: the index keeps them as vectors that packs and
+// reloads grow, so loading costs one copy of the image
+struct IndexImageHeader
+{
+    // Always indexImageMagic
+    uint32_t magic;
+
+    // Always indexImageVersion
+    uint32_t version;
+
+    // Checksum of the dictionary file the indexes were built from
+    uint64_t checksum;
+
+    // indexBuildKey() of the program that wrote the image
+    uint64_t buildKey;
+
+    // Checksum of the header (with this field zero), sections and table
+    uint64_t imageChecksum;
+
+    // Words in the dictionary
+    uint64_t wordCount;
+
+    // File offset of the section table
+    uint64_t tableOffset;
+
+    // Sections in the table
+    uint32_t sectionCount;
+
+    // Bloom filter bits set per key
+    uint32_t bloomProbes;
+
+    // Bloom filter blocks and the keys it was sized for
+    uint64_t bloomBlocks;
+    uint64_t bloomCapacity;
+
+    // Keys in the perfect hash
+    uint64_t hashKeys;
+
+    // 64-bit words per pattern bitset, by length
+    uint64_t patternBlocks[patternMaxLength + 1];
+};
+
+// Define IndexImageSection struct
+// Where one array of an index image lies in the file
+struct IndexImageSection
+{
+    // File offset of the first byte
+    uint64_t offset;
+
+    // Length in bytes
+    uint64_t bytes;
+};
+
+// Define IndexImageCursor struct
+// Walks the index arrays in image order, either writing each one to a
+// file or copying it out of a mapped image
+struct IndexImageCursor
+{
+    // True when writing
+    bool writing = false;
+
+    // Stream being written
+    ostream *out = nullptr;
+
+    // Bytes written so far
+    uint64_t offset = 0;
+
+    // Image being read
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+
+    // Section table, built while writing or read from the image
+    vector<IndexImageSection> sections;
+
+    // Next section to write or read
+    size_t next = 0;
+
+    // False once a section was missing or out of bounds
+    bool ok = true;
+
+    // Checksum of the sections written or read so far
+    uint64_t checksum = 0;
+};
+
+// Define DictionaryIndex struct
+// Lookup structures built from the loaded words
+struct DictionaryIndex
+{
+    // Fast rejection of guesses that are not words
+    BloomFilter bloom;
+
+    // Word to dense slot (Strings backend; the trie does this itself)
+    PerfectHash wordHash;
+
+    // Word ID (position in the word list) for every slot
+    vector<uint32_t> slotToId;
+
+    // Words whose hash another word already has, which the perfect hash
+    // cannot tell apart (Strings backend; almost always empty)
+    vector<uint32_t> collidingIds;
+
+    // Words the perfect hash does not hold, by spelling: the colliding
+    // words, and words merged in from packs since it was built (Strings
+    // backend)
+    unordered_map<string, uint32_t> overflowIds;
+
+    // Letter histogram of every word by ID
+    vector<LetterHistogram> histograms;
+
+    // One-letter-change graph for word ladders
+    LadderIndex ladder;
+
+    // Trie for letter grid solving
+    GridTrie gridTrie;
+
+    // Set of letters in every word by ID (26-bit mask)
+    vector<uint32_t> letterMasks;
+
+    // Spelling bee word groups
+    BeeIndex bee;
+
+    // Word IDs sorted by length, and each ID's place in that order
+    vector<uint32_t> byLength;
+    vector<uint32_t> lengthRank;
+
+    // Start of each length in byLength, plus an end marker
+    vector<uint32_t> lengthStarts;
+
+    // Mapped frequency table, and how many word IDs it covers (0 when
+    // there is none for these words)
+    MappedFile frequencies;
+    size_t frequencyCount = 0;
+
+    // Crossword pattern bitsets by length
+    array<PatternBucket, patternMaxLength + 1> patterns;
+
+    // Evil hangman words by length
+    array<HangmanBucket, hangmanMaxLength + 1> hangman;
+
+    // Wordle pattern tables by length, built on first use
+    array<WordleTable, mediumMaxLength - mediumMinLength + 1> wordle;
+
+    // The game mode indexes above are missing merged words
+    bool modesStale = false;
+
+    // Word store the IDs refer to
+    const WordStore *words = nullptr;
+};
+
+// Define DictionarySnapshot struct
+// A complete dictionary built off the game thread: the words and their
+// indexes, never changed once published
+struct DictionarySnapshot
+{
+    // Words by ID
+    WordStore words;
+
+    // Indexes over words
+    DictionaryIndex index;
+
+    // Rebuilds published so far, counting this one
+    uint64_t generation = 0;
+
+    // Generation of the words newIds maps from; 0 for the words loaded
+    // at startup
+    uint64_t baseGeneration = 0;
+
+    // New ID of each of those words, found by spelling, or noWordId for
+    // words no longer in the file
+    vector<uint32_t> newIds;
+};
+
+// Function Prototypes
+void displayIntro();                                                                                                                                                 // Show game intro
+void displayRules();                                                                                                                                                 // Show game rules
+void displayMenu(int score, int highestScore);                                                                                                                       // Show main menu
+void displayDifficultyMenu();                                                                                                                                        // Show difficulty menu
+int getDifficultyChoice();                                                                                                                                           // Get difficulty choice
+bool isEasyWord(size_t length);                                                                                                                                      // Check if word is easy
+bool isMediumWord(size_t length);                                                                                                                                    // Check if word is medium
+bool isHardWord(size_t length);                                                                                                                                      // Check if word is hard
+void filterWordsByDifficulty(vector<uint32_t> &filteredIds, const WordStore &words, int difficulty);                                                                 // Filter words
+void playGame(int &score, int &highestScore, int &streak, int &maxStreak, WordStore &words, int difficulty);                                                         // Play game
+void displayShop(WordStore &words);                                                                                                                                  // Show shop
+size_t loadWords(const string &filename, WordStore &words);                                                                                                          // Load words
+bool readLintedWords(const string &filename, LintReport &report, size_t limit, vector<string> &newWords);                                                            // Read and lint a word file
+Word scrambleWord(const Word &word);                                                                                                                                 // Scramble word
+void handleGameOver(int &score, uint32_t wordId);                                                                                                                    // Handle game over
+void updateScore(bool isCorrect, int &score, int &highestScore, int points);                                                                                         // Update scores
+void displayHintMenu();                                                                                                                                              // Show hint menu
+void useHint(const string &word, int &hintsUsed, int &score, HintPlan &plan);                                                                                        // Use hint
+void displayAchievements();                                                                                                                                          // Show achievements
+void updateAchievements(bool wonGame, int score, int hintsUsed, int timeTaken);                                                                                      // Update achievements
+void playGame();                                                                                                                                                     // Game round placeholder
+uint64_t hashWord(const string &word);                                                                                                                               // Hash a word
+void buildBloomFilter(BloomFilter &filter, size_t expectedWords, double falsePositiveRate);                                                                          // Size bloom filter
+void bloomInsert(BloomFilter &filter, const string &word);                                                                                                           // Add word to bloom filter
+bool bloomMayContain(const BloomFilter &filter, const string &word);                                                                                                 // Query bloom filter
+void buildDictionaryIndex(DictionaryIndex &index, const WordStore &words);                                                                                           // Build lookup indexes
+bool isDictionaryWord(const string &word);                                                                                                                           // Check dictionary membership
+uint64_t mixHash(uint64_t hash, uint64_t seed);                                                                                                                      // Rehash for a perfect hash level
+void buildPerfectHash(PerfectHash &table, const vector<uint64_t> &keyHashes);                                                                                        // Build perfect hash
+size_t perfectHashLookup(const PerfectHash &table, uint64_t keyHash);                                                                                                // Look up perfect hash slot
+uint32_t findWordId(const string &word);                                                                                                                             // Get ID of a word
+string wordOf(uint32_t wordId);                                                                                                                                      // Get word for an ID
+bool isAnagramOf(const string &guess, uint32_t wordId);                                                                                                              // Check same letters
+void buildWordIdHash(DictionaryIndex &index, const vector<string> &text, vector<pair<uint64_t, uint32_t>> &hashed);                                                  // Build word to ID table
+void buildRankSamples(const vector<uint64_t> &bits, vector<uint32_t> &samples);                                                                                      // Precompute rank samples
+size_t rankOnes(const vector<uint64_t> &bits, const vector<uint32_t> &samples, size_t pos);                                                                          // Count set bits before pos
+size_t selectOne(const vector<uint64_t> &bits, const vector<uint32_t> &samples, size_t k);                                                                           // Find k-th set bit
+size_t selectZero(const vector<uint64_t> &bits, const vector<uint32_t> &samples, size_t k);                                                                          // Find k-th clear bit
+void buildLoudsTrie(LoudsTrie &trie, const vector<string> &sortedWords, vector<size_t> &wordNodes);                                                                  // Build succinct trie
+size_t loudsChild(const LoudsTrie &trie, size_t node, char letter);                                                                                                  // Follow a trie edge
+size_t loudsParent(const LoudsTrie &trie, size_t node);                                                                                                              // Go up a trie edge
+size_t loudsFind(const LoudsTrie &trie, const string &word);                                                                                                         // Find node for a string
+bool loudsIsTerminal(const LoudsTrie &trie, size_t node);                                                                                                            // Check end of word
+size_t wordStoreSize(const WordStore &words);                                                                                                                        // Count stored words
+void appendWords(WordStore &words, vector<string> &newWords);                                                                                                        // Add words to store
+size_t trieOf(const WordStore &words, uint32_t wordId);                                                                                                              // Find the trie holding a word ID
+size_t wordStoreBytes(const WordStore &words);                                                                                                                       // Measure a store's memory
+string wordAt(const WordStore &words, uint32_t wordId);                                                                                                              // Get word from store
+uint32_t trieWordId(const WordStore &words, const string &word);                                                                                                     // Get ID through the trie
+void findWordsWithPrefix(const WordStore &words, const string &prefix, vector<uint32_t> &wordIds, size_t limit);                                                     // List words with prefix
+LetterHistogram computeHistogram(const string &word);                                                                                                                // Count letters of a word
+bool histogramsEqual(const LetterHistogram &a, const LetterHistogram &b);                                                                                            // Compare histograms
+bool histogramContains(const LetterHistogram &outer, const LetterHistogram &inner);                                                                                  // Check sub-histogram
+void computeHistograms(const vector<string> &words, LetterHistogram *out);                                                                                           // Count letters of many words
+void findEqualHistograms(const vector<LetterHistogram> &histograms, const LetterHistogram &target, vector<uint32_t> &wordIds);                                       // Scan for anagrams
+void findContainedHistograms(const vector<LetterHistogram> &histograms, const LetterHistogram &outer, vector<uint32_t> &wordIds);                                    // Scan for sub-anagrams
+void findAnagrams(uint32_t wordId, vector<uint32_t> &wordIds);                                                                                                       // List anagrams of a word
+void runBenchmarks();                                                                                                                                                // Time kernels against scalar loops
+HintPlan planHints(uint32_t wordId);                                                                                                                                 // Rank letter hints
+size_t nextHintPosition(HintPlan &plan);                                                                                                                             // Serve next letter hint
+void displayModesMenu();                                                                                                                                             // Show game modes menu
+void playGameModes(int &score, int &highestScore);                                                                                                                   // Pick a game mode
+uint64_t ladderBucketKey(const string &word, size_t position);                                                                                                       // Hash a wildcard bucket
+void buildLadderIndex(LadderIndex &ladder, const vector<string> &text);                                                                                              // Build ladder buckets
+void ladderNeighbors(uint32_t wordId, vector<uint32_t> &neighbors);                                                                                                  // List one-letter neighbors
+int findLadder(uint32_t fromId, uint32_t toId, int maxSteps, vector<uint32_t> &path);                                                                                // Shortest ladder search
+bool makeLadderPuzzle(uint32_t &startId, uint32_t &endId, vector<uint32_t> &path);                                                                                   // Pick ladder endpoints
+void playWordLadder(int &score, int &highestScore);                                                                                                                  // Play word ladder
+void buildGridTrie(GridTrie &trie, const vector<string> &text);                                                                                                      // Build grid solver trie
+uint32_t gridNeighborMask(size_t cell);                                                                                                                              // Cells touching a cell
+void gridSearchFrom(GridSearch &search, size_t cell, uint32_t node, uint32_t visited);                                                                               // Grid depth-first search
+void solveGrid(GridSearch &search);                                                                                                                                  // Find all words in a grid
+void randomGrid(string &grid, mt19937 &rng);                                                                                                                         // Fill a random grid
+void generateBestGrid(string &bestGrid, vector<uint32_t> &bestWords);                                                                                                // Pick the richest grid
+int gridWordPoints(size_t length);                                                                                                                                   // Score a grid word
+void playLetterGrid(int &score, int &highestScore);                                                                                                                  // Play letter grid
+uint32_t letterMaskOf(const string &word);                                                                                                                           // Get set of letters
+void buildBeeIndex(BeeIndex &bee, const vector<uint32_t> &letterMasks, const vector<string> &text);                                                                  // Group words by letter set
+size_t beeGroup(uint32_t mask);                                                                                                                                      // Find a letter-set group
+void findBeeAnswers(const BeePuzzle &puzzle, vector<uint32_t> &wordIds);                                                                                             // List spelling bee answers
+bool generateBeePuzzle(BeePuzzle &puzzle);                                                                                                                           // Pick a spelling bee
+void playSpellingBee(int &score, int &highestScore);                                                                                                                 // Play spelling bee
+bool mapFile(MappedFile &file, const string &filename);                                                                                                              // Map a file read-only
+void unmapFile(MappedFile &file);                                                                                                                                    // Release a mapped file
+uint64_t packLetters(const string &word);                                                                                                                            // Pack up to 8 letters one per byte
+uint16_t wordleFeedback(uint64_t guess, uint64_t answer, size_t length);                                                                                             // Score a guess
+void computeWordlePatterns(const vector<uint64_t> &packed, size_t length, uint16_t *patterns);                                                                       // Fill pattern matrix
+WordleTable &wordleTable(size_t length);                                                                                                                             // Get or build a pattern table
+size_t bestWordleGuess(const WordleTable &table, const vector<uint32_t> &remaining);                                                                                 // Most informative guess
+void playWordle(int &score, int &highestScore);                                                                                                                      // Play wordle
+void buildHangmanIndex(array<HangmanBucket, hangmanMaxLength + 1> &buckets, const vector<uint32_t> &letterMasks, const vector<string> &text);                        // Group hangman words by length
+uint64_t zeroByteFlags(uint64_t x);                                                                                                                                  // Flag zero bytes of a word
+uint32_t partitionHangman(const HangmanBucket &bucket, size_t length, vector<uint32_t> &candidates, char letter);                                                    // Keep the largest word family
+void playEvilHangman(int &score, int &highestScore);                                                                                                                 // Play evil hangman
+void buildPatternIndex(array<PatternBucket, patternMaxLength + 1> &buckets, const vector<uint32_t> &letterMasks, const vector<string> &text);                        // Build positional bitsets
+size_t findPatternWords(const string &pattern, vector<uint32_t> &wordIds, size_t limit);                                                                             // Match a crossword pattern
+string blanksPattern(const string &word, uint64_t shown);                                                                                                            // Hide letters of a word
+void playFillTheBlanks(int &score, int &highestScore);                                                                                                               // Play fill the blanks
+void recordPhrase(PhraseSearch &search, const vector<uint32_t> &chosen);                                                                                             // Save phrases for chosen classes
+bool phraseSearchFrom(PhraseSearch &search, LetterHistogram &remaining, size_t letters, size_t start, vector<uint32_t> &chosen, unordered_set<uint64_t> &dead, size_t &steps); // Phrase depth-first search
+size_t findPhraseAnagrams(const string &phrase, size_t maxResults, int timeLimitMs, vector<vector<uint32_t>> &phrases);                                              // Solve a phrase anagram
+void playPhraseJumble(int &score, int &highestScore);                                                                                                                // Play phrase jumble
+int64_t daysFromCivil(int year, int month, int day);                                                                                                                 // Count days since 1970-01-01
+bool parseDate(const string &text, int64_t &day);                                                                                                                    // Read a YYYY-MM-DD date
+int64_t today();                                                                                                                                                     // Get the local date as a day number
+bool generateCalendar(uint64_t seed, int64_t firstDay, uint32_t dayCount, const string &filename);                                                                   // Precompute daily puzzles
+void playDailyChallenge(int &score, int &highestScore);                                                                                                              // Play today's puzzle
+void fenwickBuild(vector<double> &tree, const vector<double> &values);                                                                                               // Build Fenwick tree
+void fenwickAdd(vector<double> &tree, size_t position, double delta);                                                                                                // Change one Fenwick value
+double fenwickPrefix(const vector<double> &tree, size_t count);                                                                                                      // Sum the first values
+size_t fenwickFind(const vector<double> &tree, double target);                                                                                                       // Find where a prefix sum passes a target
+void syncPlayerProfile(PlayerProfile &profile);                                                                                                                      // Fit a profile to the loaded words
+double adaptiveSolveChance(const PlayerProfile &profile, size_t length);                                                                                             // Predict a solve
+uint32_t pickAdaptiveWord(PlayerProfile &profile);                                                                                                                   // Sample a word for the player
+void recordAdaptiveResult(PlayerProfile &profile, uint32_t wordId, bool solved);                                                                                     // Learn from a round
+void placeReview(PlayerProfile &profile, size_t slot, const ReviewItem &item);                                                                                       // Store a heap item
+void siftReview(PlayerProfile &profile, size_t slot);                                                                                                                // Restore the review heap around a slot
+uint32_t dueReviewWord(PlayerProfile &profile);                                                                                                                      // Start a round and get a due word
+void updateReview(PlayerProfile &profile, uint32_t wordId, bool solved);                                                                                             // Reschedule a word
+void syncWordRatings(const WordStore &words);                                                                                                                        // Rate words not rated yet
+double wordRating(uint32_t wordId);                                                                                                                                  // Read a word's rating
+size_t ratedLength(double rating);                                                                                                                                   // Word length a rating plays like
+void recordRatedResult(PlayerProfile &profile, uint32_t wordId, bool solved);                                                                                        // Update both ratings
+uint64_t letterBitmap(const char *block);                                                                                                                            // Flag the letters of 64 bytes
+uint64_t sketchAdd(CountMinSketch &sketch, uint64_t hash);                                                                                                           // Count a word and estimate it
+uint64_t sketchEstimate(const CountMinSketch &sketch, uint64_t hash);                                                                                                // Estimate a word's count
+void clearIngestTable(IngestWorker &worker);                                                                                                                         // Empty a local count table
+uint64_t &ingestSlot(IngestWorker &worker, uint64_t hash, const char *word, size_t length);                                                                          // Find or add a local count
+void flushIngestTable(IngestWorker &worker, vector<IngestShard> &shards);                                                                                            // Merge local counts into the shards
+void pruneIngestTable(IngestWorker &worker);                                                                                                                         // Keep the strongest candidates
+void ingestToken(IngestWorker &worker, vector<IngestShard> &shards, const string &token);                                                                            // Count one token
+void ingestRange(IngestWorker &worker, vector<IngestShard> &shards, const char *data, size_t begin, size_t end);                                                     // Tokenize part of a corpus
+bool ingestCorpus(const string &corpusFile, const string &outputFile, size_t sketchMegabytes);                                                                       // Build a ranked dictionary
+string frequencyFileFor(const string &dictionaryFile);                                                                                                               // Name a dictionary's frequency table
+uint64_t wordListFingerprint(const vector<string> &text, size_t count);                                                                                              // Hash the first words
+uint64_t wordListFingerprint(const WordStore &words, size_t count);                                                                                                  // Hash the first stored words
+void percentiles(const vector<double> &values, vector<double> &ranks);                                                                                               // Rank values from 0 to 1
+bool compileFrequencyTable(const vector<string> &text, const vector<uint64_t> &counts, const array<double, 4> &weights, const string &filename);                     // Precompute tiers
+void loadFrequencyTable(DictionaryIndex &index, const vector<string> &text, const string &filename);                                                                 // Map a matching frequency table
+void useFrequencyTable(DictionaryIndex &index, const vector<string> &text);                                                                                          // Keep a frequency table if it matches
+const FrequencyEntry *frequencyEntry(uint32_t wordId);                                                                                                               // Get a word's table entry
+bool compileTiers(const string &dictionaryFile, const array<double, 4> &weights);                                                                                    // Rebuild tiers for a dictionary
+uint64_t byteBitmap(const char *block, char value);                                                                                                                  // Flag one byte value in 64 bytes
+size_t lintSlot(const LintReport &report, uint64_t lower);                                                                                                           // Find a word's lint table slot
+void lintInsert(LintReport &report, uint64_t lower, uint64_t spelling);                                                                                              // Add a word to a lint table
+bool lintKnows(const LintReport &report, const string &lower);                                                                                                       // Check a word was linted
+void noteLintProblem(LintReport &report, uint64_t &counter, uint64_t line, const function<string()> &describe);                                                      // Count and describe a problem
+bool lintWord(LintReport &report, const char *word, size_t length, bool alphabetic, uint64_t line);                                                                  // Check one word
+void lintConcatenation(LintReport &report, const string &word, uint64_t line);                                                                                       // Check for a glued pair
+bool streamLines(const string &filename, LintReport &report, const function<void(const char *, size_t, bool, uint64_t)> &visit);                                     // Scan a file line by line
+void printLintReport(const LintReport &report);                                                                                                                      // Show lint results
+bool lintDictionary(const string &filename, const string &outputFile);                                                                                               // Validate and normalize a dictionary
+void buildLengthOrder(DictionaryIndex &index, const WordStore &words);                                                                                               // Sort word IDs by length
+void buildModeIndexes(DictionaryIndex &index, const vector<string> &text);                                                                                           // Build game mode indexes
+void refreshModeIndexes();                                                                                                                                           // Catch mode indexes up with merged words
+void mergeDictionaryIndex(const WordStore &words, const vector<string> &newWords);                                                                                   // Add new words to the indexes
+size_t loadPack(const string &filename, WordStore &words);                                                                                                           // Load a word pack once
+uint64_t distinctPackWords(const vector<string> &packWords, vector<uint32_t> &distinct);                                                                             // Drop repeats and hash a pack
+size_t mergePack(const string &name, uint64_t contentHash, vector<string> &packWords, const vector<uint32_t> &distinct, WordStore &words);                           // Add a pack's new words
+bool ownsPack(uint64_t contentHash);                                                                                                                                 // Check a pack was merged before
+string packPath(uint64_t contentHash);                                                                                                                               // Name a pack in the cache
+bool writePackFile(const vector<string> &packWords, const vector<uint32_t> &distinct, uint64_t contentHash);                                                         // Store a binary pack
+bool readPackFile(const CatalogPack &pack, vector<string> &packWords);                                                                                               // Map and unpack a binary pack
+void loadPackCatalog();                                                                                                                                              // Read the pack catalog
+bool addCatalogPack(const string &wordFile, const string &language, const string &theme, string difficulty);                                                         // Compile a pack into the catalog
+void browsePackCatalog(WordStore &words);                                                                                                                            // Let the player pick a pack
+bool buildSnapshot(const string &filename, const WordStore &previous, DictionarySnapshot &snapshot);                                                                 // Build a dictionary off the game thread
+bool buildSnapshotWords(const string &filename, DictionarySnapshot &snapshot);                                                                                       // Build a snapshot's words and indexes
+void watchDictionary(const string &filename, WordStore previous);                                                                                                    // Rebuild the dictionary when its file changes
+void startDictionaryWatch(const string &filename, const WordStore &words);                                                                                           // Watch the dictionary in the background
+void freeSnapshot(DictionarySnapshot *snapshot);                                                                                                                     // Release a snapshot
+bool adoptSnapshot(WordStore &words);                                                                                                                                // Switch to a newer dictionary between rounds
+Word makeWord(const char *letters, size_t length);                                                                                                                   // Make a Word from letters
+Word storedWord(const WordStore &words, uint32_t wordId);                                                                                                            // Get a Word from the store
+const char *wordLetters(const Word &word);                                                                                                                           // Get a Word's letters
+string_view wordView(const Word &word);                                                                                                                              // View a Word's letters
+bool wordsEqual(const Word &a, const Word &b);                                                                                                                       // Compare two Words
+LetterHistogram wordHistogram(const Word &word);                                                                                                                     // Count letters of a Word
+void shuffleWord(Word &word);                                                                                                                                        // Shuffle a Word's letters in place
+uint64_t checksumBytes(const uint8_t *data, size_t size);                                                                                                            // Checksum a block of bytes
+bool fileChecksum(const string &filename, uint64_t &checksum);                                                                                                       // Checksum a file
+uint64_t indexBuildKey();                                                                                                                                            // Key an index image to this build
+uint64_t imageChecksum(IndexImageHeader header, const IndexImageCursor &cursor);                                                                                     // Checksum a whole index image
+const uint8_t *imageSpan(IndexImageCursor &cursor, const void *data, size_t count, size_t elementSize, size_t &readCount);                                           // Write or read one image section
+void imageArray(IndexImageCursor &cursor, vector<uint64_t> &values);                                                                                                 // Write or read a 64-bit array
+void imageArray(IndexImageCursor &cursor, vector<uint32_t> &values);                                                                                                 // Write or read a 32-bit array
+void imageArray(IndexImageCursor &cursor, vector<uint8_t> &values);                                                                                                  // Write or read a byte array
+void imageArray(IndexImageCursor &cursor, vector<LetterHistogram> &values);                                                                                          // Write or read histograms
+void imageArray(IndexImageCursor &cursor, string &values);                                                                                                           // Write or read letters
+void visitIndexImage(IndexImageCursor &cursor, DictionaryIndex &index, WordStore &words, string &letters);                                                           // Walk the image arrays in order
+bool idsInRange(const vector<uint32_t> &wordIds, size_t wordCount, bool noneAllowed);                                                                                // Check word IDs from an image
+bool groupsInRange(const vector<uint32_t> &starts, size_t groups, size_t entries);                                                                                   // Check group starts from an image
+bool indexImageConsistent(const DictionaryIndex &index, const IndexImageHeader &header);                                                                             // Check arrays read from an image
+bool writeIndexImage(const string &filename, uint64_t checksum, DictionaryIndex &index, WordStore &words);                                                           // Save built indexes
+bool readIndexImage(const string &filename, uint64_t checksum, DictionaryIndex &index, WordStore &words);                                                            // Load saved indexes
+size_t loadDictionary(const string &filename, WordStore &words, DictionaryIndex &index);                                                                             // Load words and indexes
+void saveIndexImage(ostream &out, uint64_t checksum, DictionaryIndex &index, WordStore &words);                                                                      // Write an index image
+bool copyIndexImage(const uint8_t *data, size_t size, uint64_t checksum, DictionaryIndex &index, WordStore &words);                                                  // Load indexes from memory
+size_t loadDefaultDictionary(WordStore &words, DictionaryIndex &index);                                                                                              // Load the compiled-in or file dictionary
+bool embedDictionary(const string &dictionaryFile, const string &headerFile);                                                                                        // Generate the compiled-in dictionary
+void writeByteLiteral(ostream &out, const uint8_t *data, size_t size);                                                                                               // Write bytes as a string literal
+
+// Define the number of achievements
+const int numAchievements = 4;
+
+// Define Achievement struct
+struct Achievement
+{
+    // Achievement name
+    string name;
+
+    // Achievement description
+    string description;
+
+    // Achievement status
+    bool achieved;
+
+    // Default constructor
+    Achievement() : name(""), description(""), achieved(false) {}
+
+    // Constructor with parameters
+    Achievement(string n, string d) : name(n), description(d), achieved(false) {}
+};
+
+// Array of achievements with a fixed size
+array<Achievement, numAchievements> achievements = {
+    // First Achievement
+    Achievement("First Win", "Win your first game"),
+    // Second Achievement
+    Achievement("Hint Master", "Win without using a hint"),
+    // Third Achievement
+    Achievement("High Scorer", "Reach a score of 50 or more"),
+    // Fourth Achievement
+    Achievement("Quick Thinker", "Win within 30 seconds")};
+
+// Lookup indexes for the loaded words
+DictionaryIndex dictionaryIndex;
+
+// Letters of the Words too long to hold inline, back to back. Only the
+// game thread makes Words, and each round or jumble cuts the arena back
+// to where it started, so it holds one round's long words at most
+string wordArena;
+
+// Problems found in the words loaded so far
+LintReport loadLint;
+
+// What the game has learned about the player
+PlayerProfile player;
+
+// Rating of every word by ID, shared by all players
+vector<atomic<float>> wordRatings;
+
+// Word packs merged in so far
+vector<WordPack> loadedPacks;
+
+// Packs the shop offers, read when the catalog is first opened
+vector<CatalogPack> packCatalog;
+
+// Newest dictionary rebuilt in the background that the game has not
+// picked up yet, handed over by an atomic exchange
+atomic<DictionarySnapshot *> pendingSnapshot(nullptr);
+
+// Generation of the dictionary the game is playing; read and written
+// only on the game thread
+uint64_t dictionaryGeneration = 0;
+
+// Heap allocations made through operator new; stays 0 unless the
+// build counts them
+atomic<uint64_t> heapAllocations(0);
+
+#ifdef UNSCRAMBLE_COUNT_ALLOCATIONS
+// Function to count and make one allocation for the operator news below
+// Returns nullptr when memory runs out; everything it returns is freed
+// with free()
+void *countedAllocation(size_t size, size_t alignment)
+{
+    heapAllocations.fetch_add(1, memory_order_relaxed);
+    size = max<size_t>(size, 1);
+    if (alignment <= alignof(max_align_t))
+    {
+        return malloc(size);
+    }
+    return aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+// Function to make a counted allocation or throw bad_alloc
+void *countedAllocationOrThrow(size_t size, size_t alignment)
+{
+    void *memory = countedAllocation(size, alignment);
+    if (memory == nullptr)
+    {
+        throw bad_alloc();
+    }
+    return memory;
+}
+
+// The complete set of replaceable operator news: plain, array, nothrow
+// and aligned
+void *operator new(size_t size)
+{
+    return countedAllocationOrThrow(size, 0);
+}
+
+void *operator new[](size_t size)
+{
+    return countedAllocationOrThrow(size, 0);
+}
+
+void *operator new(size_t size, const nothrow_t &) noexcept
+{
+    return countedAllocation(size, 0);
+}
+
+void *operator new[](size_t size, const nothrow_t &) noexcept
+{
+    return countedAllocation(size, 0);
+}
+
+void *operator new(size_t size, align_val_t alignment)
+{
+    return countedAllocationOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void *operator new[](size_t size, align_val_t alignment)
+{
+    return countedAllocationOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void *operator new(size_t size, align_val_t alignment, const nothrow_t &) noexcept
+{
+    return countedAllocation(size, static_cast<size_t>(alignment));
+}
+
+void *operator new[](size_t size, align_val_t alignment, const nothrow_t &) noexcept
+{
+    return countedAllocation(size, static_cast<size_t>(alignment));
+}
+
+// And every matching operator delete: plain, array, sized, nothrow and
+// aligned
+void operator delete(void *memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void *memory, size_t) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void *memory, const nothrow_t &) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void *memory, const nothrow_t &) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void *memory, align_val_t) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void *memory, align_val_t) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void *memory, size_t, align_val_t) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void *memory, size_t, align_val_t) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void *memory, align_val_t, const nothrow_t &) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void *memory, align_val_t, const nothrow_t &) noexcept
+{
+    free(memory);
+}
+#endif
+
+// Main function where the program starts execution
+int main(int argc, char *argv[])
+{
+    // The word store backend can be chosen ahead of any mode; the
+    // arguments after it are read as if it were not there
+    // Run with: cis17c_project1 --backend <strings|succinct> [mode ...]
+    if (argc > 1 && string(argv[1]) == "--backend")
+    {
+        string backend = argc > 2 ? argv[2] : "";
+        if (backend != "strings" && backend != "succinct")
+        {
+            cout << "Usage: " << argv[0] << " --backend <strings|succinct> [mode ...]\n";
+            return 1;
+        }
+        wordBackend = backend == "succinct" ? WordBackend::Succinct : WordBackend::Strings;
+        argv[2] = argv[0];
+        argv += 2;
+        argc -= 2;
+    }
+
+    // Benchmark mode runs the kernels and exits
+    if (argc > 1 && string(argv[1]) == "--bench")
+    {
+        runBenchmarks();
+        return 0;
+    }
+
+    // Calendar mode precomputes daily puzzles and exits
+    // Run with: cis17c_project1 --calendar <seed> <YYYY-MM-DD> <days>
+    if (argc > 1 && string(argv[1]) == "--calendar")
+    {
+        int64_t firstDay = 0;
+        if (argc < 5 || !parseDate(argv[3], firstDay) || atoi(argv[4]) <= 0)
+        {
+            cout << "Usage: " << argv[0] << " --calendar <seed> <YYYY-MM-DD> <days>\n";
+            return 1;
+        }
+        WordStore words;
+        words.backend = wordBackend;
+        loadDefaultDictionary(words, dictionaryIndex);
+        syncWordRatings(words);
+        if (!generateCalendar(strtoull(argv[2], nullptr, 10), firstDay, static_cast<uint32_t>(atoi(argv[4])), calendarFile))
+        {
+            cout << "No daily puzzles could be made from dictionary.txt.\n";
+            return 1;
+        }
+        cout << "Wrote " << argv[4] << " daily puzzles starting " << argv[3] << " to " << calendarFile << ".\n";
+        return 0;
+    }
+
+    // Ingest mode counts the words of a text corpus and exits
+    // Run with: cis17c_project1 --ingest <corpus> <output> [sketch MB]
+    if (argc > 1 && string(argv[1]) == "--ingest")
+    {
+        if (argc < 4)
+        {
+            cout << "Usage: " << argv[0] << " --ingest <corpus> <output> [sketch MB]\n";
+            return 1;
+        }
+        return ingestCorpus(argv[2], argv[3], argc > 4 ? static_cast<size_t>(atoi(argv[4])) : 0) ? 0 : 1;
+    }
+
+    // Tiers mode rebuilds a dictionary's difficulty tiers and exits
+    // Run with: cis17c_project1 --tiers <dictionary> [frequency length rarity ambiguity]
+    if (argc > 1 && string(argv[1]) == "--tiers")
+    {
+        array<double, 4> weights = {tierWeightFrequency, tierWeightLength, tierWeightRarity, tierWeightAmbiguity};
+        if (argc != 3 && argc != 7)
+        {
+            cout << "Usage: " << argv[0] << " --tiers <dictionary> [frequency length rarity ambiguity]\n";
+            return 1;
+        }
+        for (int i = 3; i < argc; i++)
+        {
+            weights[i - 3] = max(0.0, atof(argv[i]));
+        }
+        return compileTiers(argv[2], weights) ? 0 : 1;
+    }
+
+    // Lint mode checks a dictionary file and exits
+    // Run with: cis17c_project1 --lint <dictionary> [normalized output]
+    if (argc > 1 && string(argv[1]) == "--lint")
+    {
+        if (argc < 3)
+        {
+            cout << "Usage: " << argv[0] << " --lint <dictionary> [normalized output]\n";
+            return 1;
+        }
+        return lintDictionary(argv[2], argc > 3 ? argv[3] : "") ? 0 : 1;
+    }
+
+    // Pack mode compiles a word list into the shop's pack catalog and exits
+    // Run with: cis17c_project1 --pack <word file> <language> <theme> [easy|medium|hard]
+    if (argc > 1 && string(argv[1]) == "--pack")
+    {
+        if (argc < 5)
+        {
+            cout << "Usage: " << argv[0] << " --pack <word file> <language> <theme> [easy|medium|hard]\n";
+            return 1;
+        }
+        return addCatalogPack(argv[2], argv[3], argv[4], argc > 5 ? argv[5] : "") ? 0 : 1;
+    }
+
+    // Embed mode generates the compiled-in default dictionary and exits
+    // Run with: cis17c_project1 --embed <dictionary> default_dictionary.h
+    if (argc > 1 && string(argv[1]) == "--embed")
+    {
+        if (argc < 4)
+        {
+            cout << "Usage: " << argv[0] << " --embed <dictionary> default_dictionary.h\n";
+            return 1;
+        }
+        return embedDictionary(argv[2], argv[3]) ? 0 : 1;
+    }
+
+    // Seed the random number generator
+    srand(static_cast<unsigned int>(time(0)));
+
+    // Initialize player's score
+    int score = 0;
+
+    // Initialize highest score variable
+    int highestScore = 0;
+
+    // Current streak of consecutive correct guesses
+    int streak = 0;
+
+    // Highest streak reached
+    int maxStreak = 0;
+
+    // Display game intro
+    displayIntro();
+
+    // Display game rules
+    displayRules();
+
+    // Wait for the user to press enter
+    cin.get();
+
+    // Store for the words from the file
+    WordStore words;
+    words.backend = wordBackend;
+
+    // Load initial words with their lookup indexes, from the compiled-in
+    // dictionary or the saved image when the file has not changed, then
+    // rate the words
+    loadDefaultDictionary(words, dictionaryIndex);
+    syncWordRatings(words);
+
+#ifndef UNSCRAMBLE_EMBEDDED_DICTIONARY
+    // Rebuild in the background whenever the file changes
+    startDictionaryWatch("dictionary.txt", words);
+#endif
+
+    // Variable to track if the game should exit
+    bool exitGame = false;
+
+    // Main game loop
+    while (!exitGame)
+    {
+        // Pick up a reloaded dictionary between rounds
+        if (adoptSnapshot(words))
+        {
+            cout << "dictionary.txt changed; " << wordStoreSize(words) << " words are now loaded.\n";
+        }
+
+        // Display Achievements
+        playGame();
+
+        // Display game menu with score
+        displayMenu(score, highestScore);
+
+        // Variable to store the menu option selected
+        int option;
+
+        // Prompt on what user should input
+        cout << "Enter your selection: ";
+
+        // Validate input
+        while (!(cin >> option))
+        {
+            // Clear the error flag on cin
+            cin.clear();
+
+            // Ignore the rest of the line
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+            // Prompt user to enter a number
+            cout << "Invalid selection. Please enter a number: ";
+        }
+
+        // Process menu option
+        switch (option)
+        {
+        // Start a new game
+        case 1:
+        {
+            // Get difficulty choice from the player
+            int difficulty = getDifficultyChoice();
+
+            // Start the game with chosen difficulty
+            playGame(score, highestScore, streak, maxStreak, words, difficulty);
+
+            // Break out of switch case
+            break;
+        }
+
+        // Display the shop
+        case 2:
+            // displayShop Function will run
+            displayShop(words);
+
+            // Break out of switch case
+            break;
+
+        // Choose another game mode
+        case 3:
+            // playGameModes Function will run
+            playGameModes(score, highestScore);
+
+            // Break out of switch case
+            break;
+
+        // Exit the game
+        case 4:
+            // exitGame will be true
+            exitGame = true;
+
+            // Prompt user that game is exiting
+            cout << "Exiting the game.\n";
+
+            // Break out of switch case
+            break;
+
+        // Handle invalid selection
+        default:
+
+            // Prompt user to enter a number 1-4
+            cout << "Invalid selection. Please enter a number between 1 and 4.\n";
+
+            // Break out of switch case
+            break;
+        }
+    }
+
+    // End program
+    return 0;
+}
+
+// Function to display introductory text for the game
+void displayIntro()
+{
+    cout << "\n\n";
+    cout << "****************************************\n";
+    cout << "*              UNSCRAMBLE              *\n";
+    cout << "****************************************\n";
+    cout << "* Hello Welcome to my Unscramble game! *\n";
+    cout << "* This program is a word unscrambling  *\n";
+    cout << "* game where players are presented with*\n";
+    cout << "* scrambled words and must guess the   *\n";
+    cout << "* correct word. The game includes      *\n";
+    cout << "* various difficulty levels, achieveme *\n";
+    cout << "* nts, hints, scoring with combo points*\n";
+    cout << "* and a shop for additional words.     *\n";
+    cout << "* Created by \"Vannara Thong\"         *\n";
+    cout << "****************************************\n";
+}
+
+// Function to display the rules of the game
+// This provides players with instructions on how to play and what to expect
+void displayRules()
+{
+    cout << "****************************************\n";
+    cout << "*                 RULES                *\n";
+    cout << "****************************************\n";
+    cout << "* You'll be given a word to unscramble *\n";
+    cout << "* and must solve it within 3 tries.    *\n";
+    cout << "* Points are awarded based on word     *\n";
+    cout << "* length and difficulty level chosen.  *\n";
+    cout << "* If the word is guessed incorrectly a *\n";
+    cout << "* point will be taken from your score. *\n";
+    cout << "****************************************\n";
+    cout << "Press \"Enter\" to continue.\n";
+}
+
+// Function to display the main menu with the current score and highest score
+// Shows the player their progress and offers options to play, shop, or exit
+void displayMenu(int score, int highestScore)
+{
+    cout << "\n****************************************\n";
+    cout << "* Current Score: " << score << setw(23) << "*\n";
+    cout << "* Highest Score: " << highestScore << setw(23) << "*\n";
+    cout << "****************************************\n";
+    cout << "Choose an option from the menu\n";
+    cout << "1. Play the game\n";
+    cout << "2. Shop\n";
+    cout << "3. More game modes\n";
+    cout << "4. Exit the game\n";
+    // cout << "Enter your selection: ";
+}
+
+// Function to display the difficulty menu for the player
+// Provides the player with difficulty level options before starting a game
+void displayDifficultyMenu()
+{
+    cout << "\nSelect Difficulty Level:\n";
+    cout << "1. Easy (3-5 letters)\n";
+    cout << "2. Medium (6-8 letters)\n";
+    cout << "3. Hard (9+ letters)\n";
+    cout << "4. Adaptive (matched to your skill)\n";
+    cout << "Enter your choice: ";
+}
+
+// Function to retrieve the difficulty choice from the player
+// Prompts the player to select a difficulty level and returns their choice
+int getDifficultyChoice()
+{
+    // Display the difficulty menu
+    displayDifficultyMenu();
+
+    // Variable to store difficulty choice
+    int difficulty;
+
+    // Get difficulty choice from user
+    // This can be easy, medium, and hard
+    cin >> difficulty;
+
+    // Return chosen difficulty
+    return difficulty;
+}
+
+// Helper function to check if a word is an "Easy" word
+bool isEasyWord(size_t length)
+{
+    // Check if word length falls within easy range
+    return length >= easyMinLength && length <= easyMaxLength;
+}
+
+// Helper function to check if a word is a "Medium" word
+bool isMediumWord(size_t length)
+{
+    // Check if word length falls within medium range
+    return length >= mediumMinLength && length <= mediumMaxLength;
+}
+
+// Helper function to check if a word is a "Hard" word
+bool isHardWord(size_t length)
+{
+    // Check if word length is within hard range
+    return length >= hardMinLength;
+}
+
+// Function to filter words by selected difficulty level
+void filterWordsByDifficulty(vector<uint32_t> &filteredIds, const WordStore &words, int difficulty)
+{
+    // Start with an empty filtered list
+    filteredIds.clear();
+
+    // Loop through each word length in the store
+    for (size_t i = 0; i < words.lengths.size(); ++i)
+    {
+        // Check if word matches the selected difficulty level
+        // Words in the frequency table keep its precomputed tier; the
+        // rest are tiered by the length their rating plays like
+        const FrequencyEntry *entry = frequencyEntry(static_cast<uint32_t>(i));
+        bool matches = false;
+        if (entry != nullptr && entry->tier != 0)
+        {
+            matches = entry->tier == difficulty;
+        }
+        else
+        {
+            size_t length = i < wordRatings.size() ? ratedLength(wordRating(static_cast<uint32_t>(i))) : words.lengths[i];
+            matches = (difficulty == 1 && isEasyWord(length)) ||
+                      (difficulty == 2 && isMediumWord(length)) ||
+                      (difficulty == 3 && isHardWord(length));
+        }
+        if (matches)
+        {
+            // Add the matching word's ID to the filtered list
+            filteredIds.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+// Function to display hint menu
+void displayHintMenu()
+{
+    cout << "\nAvailable Hints:\n";
+    cout << "1. Reveal the first letter\n";
+    cout << "2. Show word length\n";
+    cout << "3. Reveal the most helpful letter\n";
+    cout << "4. Fill in the blanks\n";
+    cout << "Enter your choice: ";
+}
+
+// Function to provide a hint to the player and update score
+void useHint(const string &word, int &hintsUsed, int &score, HintPlan &plan)
+{
+    // Check if maximum hints have been used
+    if (hintsUsed >= maxHintsPerWord)
+    {
+        cout << "You have used all available hints for this word.\n";
+        return;
+    }
+
+    // Display the hint menu
+    displayHintMenu();
+    int hintChoice;
+    cin >> hintChoice;
+
+    // Process the player's hint choice
+    if (hintChoice == 1) // Reveal the first letter
+    {
+        cout << "First letter: " << word[0] << endl;
+
+        // Letter hints skip the first position from now on
+        plan.revealed |= 1;
+    }
+    else if (hintChoice == 2) // Show the word length
+    {
+        cout << "Word length: " << word.length() << " letters.\n";
+    }
+    else if (hintChoice == 3) // Reveal the most helpful letter
+    {
+        // Take the best position not shown yet
+        size_t position = nextHintPosition(plan);
+        if (position >= word.length())
+        {
+            cout << "Every letter has already been revealed.\n";
+            return;
+        }
+        cout << "Revealed letter at position " << position + 1 << ": " << word[position] << endl;
+    }
+    else if (hintChoice == 4) // Fill in the blanks
+    {
+        // Show one more letter, then how many words fit the letters shown
+        size_t position = nextHintPosition(plan);
+        string pattern = blanksPattern(word, plan.revealed);
+        vector<uint32_t> fits;
+        size_t count = findPatternWords(pattern, fits, 0);
+        if (position < word.length())
+        {
+            cout << "Revealed letter at position " << position + 1 << ". ";
+        }
+        cout << "Pattern: " << pattern << " (" << count << " dictionary word" << (count == 1 ? "" : "s") << " fit it)\n";
+    }
+    else
+    {
+        cout << "Invalid hint choice.\n";
+        return;
+    }
+
+    // Increment hint usage
+    hintsUsed++;
+
+    // Deduct points
+    score -= hintCost;
+
+    // Display the current score
+    cout << "Hint cost deducted. Current score: " << score << endl;
+}
+
+// Function to play the game with streak and combo points
+void playGame(int &score, int &highestScore, int &streak, int &maxStreak, WordStore &words, int difficulty)
+{
+    // Check if there are any loaded words to play with
+    if (wordStoreSize(words) == 0)
+    {
+        // Display error and exit function if no words are available
+        cout << "Error: No words loaded from the dictionary files.\n";
+
+        // Breaks out of this if statement
+        return;
+    }
+
+    // A missed word that is due for review comes first
+    uint32_t wordId = dueReviewWord(player);
+    if (wordId != noWordId)
+    {
+        cout << "Review: you missed this word before.\n";
+    }
+
+    // Adaptive play samples a word matched to the player's skill
+    else if (difficulty == 4)
+    {
+        wordId = pickAdaptiveWord(player);
+    }
+    else
+    {
+        // Declare a list to store IDs of words filtered by difficulty
+        // Kept between rounds, so its buffer is only grown once
+        static vector<uint32_t> filteredIds;
+
+        // Filter the loaded words by selected difficulty level
+        filterWordsByDifficulty(filteredIds, words, difficulty);
+
+        // Select a random word from the filtered list
+        if (!filteredIds.empty())
+        {
+            wordId = filteredIds[static_cast<size_t>(rand()) % filteredIds.size()];
+        }
+    }
+
+    // Check if there are words available for the chosen difficulty
+    if (wordId == noWordId)
+    {
+        // Display message if no matching words are found
+        cout << "No words available for the selected difficulty level.\n";
+
+        // Breaks out of this if statement
+        return;
+    }
+
+    // The round keys everything off the word's ID; the word and its
+    // scramble are held by value, long ones borrowing the arena
+    size_t roundArena = wordArena.size();
+    Word word = storedWord(words, wordId);
+
+    // Scramble the selected word to create an anagram
+    Word scrambledWord = scrambleWord(word);
+
+    // Display the unscramble word
+    cout << "Anagram of the word is: " << wordView(scrambledWord) << endl;
+
+    // Rank letter hints in the background while the player thinks
+    future<HintPlan> pendingHints = async(launch::async, planHints, wordId);
+    HintPlan hintPlan;
+
+    // Initialize the number of attempts and hints
+    // Total attempts allowed per word
+    int attemptsLeft = 3;
+
+    // Number of hints available per word
+    // Track the number of hints used
+    int hintsUsed = 0;
+
+    // Variable to store player's guess
+    string guess;
+
+    // Track if the word was guessed correctly
+    bool wordGuessed = false;
+
+    // Main loop for guessing attempts
+    while (attemptsLeft > 0 && !wordGuessed)
+    {
+        // Prompt the player for a guess
+        cout << "Guess the word (or type 'hint' for a hint): ";
+        cin >> guess;
+
+        // Check if the player requested a hint
+        if (guess == "hint")
+        {
+            // Provide a hint and continue the loop without using an attempt
+            if (pendingHints.valid())
+            {
+                hintPlan = pendingHints.get();
+            }
+            useHint(string(wordView(word)), hintsUsed, score, hintPlan);
+
+            // Continues the flow of code
+            continue;
+        }
+
+        // Only the word itself wins. Other guesses are compared by letter
+        // histogram, to tell the player they have the right letters, and
+        // checked against the dictionary, non-words stopping at the bloom
+        // filter, to say why they missed
+        size_t guessArena = wordArena.size();
+        Word guessWord = makeWord(guess.data(), guess.length());
+        bool exact = wordsEqual(guessWord, word);
+        bool sameLetters = !exact && histogramsEqual(wordHistogram(guessWord), dictionaryIndex.histograms[wordId]);
+        wordArena.resize(guessArena);
+        bool knownWord = exact || isDictionaryWord(guess);
+
+        // Check if the player's guess is correct
+        if (exact)
+        {
+            // Calculate points based on word rating and combo streak
+            int points = static_cast<int>(ratedLength(wordRating(wordId)));
+
+            // Example: 2 extra points per streak level
+            int comboBonus = streak * 2;
+
+            // Bonus increases points
+            points += comboBonus;
+
+            // Increment the streak and update max streak if new streak is higher
+            streak++;
+
+            // Increase max streak value
+            if (streak > maxStreak)
+            {
+                // Maxstreak takes value of streak
+                maxStreak = streak;
+            }
+
+            // Display points earned, including combo points
+            cout << "Correct! You earned " << points << " points (including " << comboBonus << " combo points)!\n";
+            cout << "Current streak: " << streak << " | Max streak: " << maxStreak << endl;
+
+            // Mention any other words hiding in the same letters
+            vector<uint32_t> anagramIds;
+            findAnagrams(wordId, anagramIds);
+            string others;
+            for (uint32_t otherId : anagramIds)
+            {
+                string other = wordOf(otherId);
+                if (other != guess && others.find(" " + other + ",") == string::npos)
+                {
+                    others += " " + other + ",";
+                }
+            }
+            if (!others.empty())
+            {
+                others.pop_back();
+                cout << "These letters also spell:" << others << endl;
+            }
+
+            // Update the score with points and end the round
+            updateScore(true, score, highestScore, points);
+            wordGuessed = true;
+        }
+        else
+        {
+            // Deduct an attempt if the guess was incorrect
+            attemptsLeft--;
+
+            // Tell the player when the guess is an anagram of the word, or
+            // not a word at all
+            if (sameLetters && knownWord)
+            {
+                cout << "Right letters, wrong word.\n";
+            }
+            else if (sameLetters)
+            {
+                cout << "Right letters, but \"" << guess << "\" is not in the word list.\n";
+            }
+            else if (!knownWord)
+            {
+                cout << "\"" << guess << "\" is not in the word list.\n";
+            }
+
+            cout << "Incorrect guess. Attempts left: " << attemptsLeft << endl;
+
+            // Reset the streak since the guess was incorrect
+            streak = 0;
+        }
+    }
+
+    // The round's Words are done with; give back their arena letters
+    wordArena.resize(roundArena);
+
+    // If the player didn't guess the word correctly, handle game over
+    if (!wordGuessed)
+    {
+        handleGameOver(score, wordId);
+    }
+
+    // Learn from the round for adaptive play and the ratings
+    recordAdaptiveResult(player, wordId, wordGuessed);
+    recordRatedResult(player, wordId, wordGuessed);
+
+    // A solved word moves further out in the review schedule
+    if (wordGuessed)
+    {
+        updateReview(player, wordId, true);
+    }
+
+    // Prompt the user to press Enter to continue
+    cout << "Press \"Enter\" to continue.\n";
+    cin.ignore();
+    cin.get();
+}
+
+// Function to display shop and offer more words
+void displayShop(WordStore &words)
+{
+    // Display shop menu options
+    cout << "Welcome to the shop.\n";
+    cout << "1. Load more difficult words\n";
+    cout << "2. Browse word packs\n";
+    cout << "3. Exit shop\n";
+    cout << "Enter your choice: ";
+
+    // Get user's choice
+    int shopOption;
+
+    // User input an option
+    cin >> shopOption;
+
+    // Check if user chose to load more words
+    if (shopOption == 1)
+    {
+        // Merge the pack's new words into the store and its indexes;
+        // the loader reports how it went
+        loadPack("dictionary2.txt", words);
+    }
+    else if (shopOption == 2)
+    {
+        // Pick a pack from the catalog
+        browsePackCatalog(words);
+    }
+    else
+    {
+        // Exit the shop if the user chose to
+        cout << "Exiting the shop.\n";
+    }
+
+    // Prompt user to press Enter to continue
+    cout << "Press \"Enter\" to continue.\n";
+    cin.ignore();
+    cin.get();
+}
+
+// Function to load words from a file into the word store
+size_t loadWords(const string &filename, WordStore &words)
+{
+    // Words read from this file, until the store reaches maxWords
+    // Each word is linted against every word loaded before it
+    vector<string> newWords;
+    readLintedWords(filename, loadLint, maxWords - min(maxWords, wordStoreSize(words)), newWords);
+
+    // Hand the words to the store's backend
+    appendWords(words, newWords);
+
+    // Return the number of words loaded
+    return newWords.size();
+}
+
+// Function to read up to limit words from a file, linting each against
+// the words the report has seen. Returns false if the file can't be read
+bool readLintedWords(const string &filename, LintReport &report, size_t limit, vector<string> &newWords)
+{
+    // Open the file
+    ifstream file(filename);
+    if (!file)
+    {
+        return false;
+    }
+
+    // Read and lint the words
+    string word;
+    uint64_t problems = report.duplicates + report.nonAlphabetic + report.caseCollisions + report.overLong;
+    while (newWords.size() < limit && file >> word)
+    {
+        bool alphabetic = all_of(word.begin(), word.end(), [](char c)
+                                 { return static_cast<uint8_t>((c | 0x20) - 'a') < 26; });
+        lintWord(report, word.data(), word.length(), alphabetic, newWords.size() + 1);
+        newWords.push_back(word);
+    }
+
+    // Mention new problems briefly
+    if (report.duplicates + report.nonAlphabetic + report.caseCollisions + report.overLong > problems)
+    {
+        cout << filename << " has " << report.duplicates + report.nonAlphabetic + report.caseCollisions + report.overLong - problems
+             << " suspect word(s). Run with --lint " << filename << " for details.\n";
+    }
+    return true;
+}
+
+// Function to scramble a word to create an anagram
+Word scrambleWord(const Word &word)
+{
+    // Copy the original word to scramble
+    Word anagram = word;
+
+    // Swap each letter with a random one
+    shuffleWord(anagram);
+
+    // Return the scrambled word
+    return anagram;
+}
+
+// Function to handle game over scenario
+void handleGameOver(int &score, uint32_t wordId)
+{
+    // Display the correct answer
+    cout << "Game Over! The correct answer was \"" << wordOf(wordId) << "\"\n";
+
+    // Bring the word back for review in a few rounds
+    updateReview(player, wordId, false);
+
+    // Reset the score to zero
+    score = 0;
+}
+
+// Function to update score and track highest score
+void updateScore(bool isCorrect, int &score, int &highestScore, int points)
+{
+    // If the answer is correct
+    if (isCorrect)
+    {
+        // Add points based on word length
+        score += points;
+
+        // Update highest score if needed
+        if (score > highestScore)
+        {
+            // Highest Score will equal the current score
+            highestScore = score;
+        }
+    }
+    else
+    {
+        // Deduct one point for incorrect answer
+        score--;
+    }
+}
+
+// Function to display all achievements and their status
+void displayAchievements()
+{
+    // Print achievement header
+    cout << "\nAchievements:\n";
+
+    // Loop through each achievement
+    for (const auto &achievement : achievements)
+    {
+        // Display achievement name
+        cout << "- " << achievement.name << ": ";
+
+        // Display status if achieved
+        if (achievement.achieved)
+        {
+            cout << "Achieved! ";
+        }
+
+        // Display achievement description
+        cout << "(" << achievement.description << ")\n";
+    }
+
+    // Add extra line for spacing
+    cout << endl;
+}
+
+// Function to check and update achievements based on game progress
+// Function do not award player
+void updateAchievements(bool wonGame, int score, int hintsUsed, int timeTaken)
+{
+    // Check if "First Win" achievement is earned
+    if (wonGame && !achievements[0].achieved)
+    {
+        // Achievement 1
+        achievements[0].achieved = true;
+
+        // Prompt User that achievement is earned
+        cout << "Congratulations! You earned the achievement: " << achievements[0].name << "!\n";
+    }
+
+    // Check if "Hint Master" achievement is earned
+    if (wonGame && hintsUsed == 0 && !achievements[1].achieved)
+    {
+        // Achievement 2
+        achievements[1].achieved = true;
+
+        // Prompt User that achievement is earned
+        cout << "Amazing! You earned the achievement: " << achievements[1].name << "!\n";
+    }
+
+    // Check if "High Scorer" achievement is earned
+    if (score >= 50 && !achievements[2].achieved)
+    {
+        // Achievement 3
+        achievements[2].achieved = true;
+
+        // Prompt User that achievement is earned
+        cout << "Impressive! You earned the achievement: " << achievements[2].name << "!\n";
+    }
+
+    // Check if "Quick Thinker" achievement is earned
+    if (wonGame && timeTaken <= 30 && !achievements[3].achieved)
+    {
+        // Achievement 4
+        achievements[3].achieved = true;
+
+        // Prompt User that achievement is earned
+        cout << "Fast thinking! You earned the achievement: " << achievements[3].name << "!\n";
+    }
+}
+
+// Function to simulate a game round and check achievements
+// This function will run after each played game
+void playGame()
+{
+    // Track the player's score
+    int score = 0;
+
+    // Track number of hints used
+    int hintsUsed = 0;
+
+    // Time taken to win the game in seconds
+    int timeTaken = 25;
+
+    // Did the player win the game?
+    bool wonGame = true;
+
+    // Example score increment after winning a game
+    score += 10;
+
+    // Assume no hints were used this round
+    hintsUsed = 0;
+
+    // Check for new achievements
+    updateAchievements(wonGame, score, hintsUsed, timeTaken);
+
+    // Display all achievements
+    displayAchievements();
+}
+
+// Function to hash a word into 64 bits
+// FNV-1a followed by a final mix so every output bit depends on every letter
+uint64_t hashWord(const string &word)
+{
+    // FNV-1a over the characters
+    uint64_t hash = 1469598103934665603ULL;
+    for (char c : word)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+
+    // Final avalanche mix
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+
+    // Return the mixed hash
+    return hash;
+}
+
+// Function to size an empty bloom filter for a number of words
+void buildBloomFilter(BloomFilter &filter, size_t expectedWords, double falsePositiveRate)
+{
+    // Optimal bits per key for the target rate, plus a little
+    // headroom because blocking makes bits less evenly spread
+    double bitsPerKey = -log(falsePositiveRate) / (log(2.0) * log(2.0)) * 1.1;
+
+    // Round the total up to whole blocks
+    size_t totalBits = static_cast<size_t>(static_cast<double>(max<size_t>(expectedWords, 1)) * bitsPerKey);
+    filter.blockCount = max<size_t>(1, (totalBits + bloomBlockBits - 1) / bloomBlockBits);
+
+    // Pick the number of probes that minimizes false positives
+    filter.probes = static_cast<int>(lround(bitsPerKey / 1.1 * log(2.0)));
+    filter.probes = min(max(filter.probes, 1), 16);
+
+    // Clear the filter bits
+    filter.bits.assign(filter.blockCount * (bloomBlockBits / 64), 0);
+    filter.capacity = expectedWords;
+}
+
+// Function to add a word to the bloom filter
+void bloomInsert(BloomFilter &filter, const string &word)
+{
+    // Pick the block from the high half of the hash
+    uint64_t hash = hashWord(word);
+    size_t block = static_cast<size_t>(((hash >> 32) * filter.blockCount) >> 32);
+    uint64_t *bits = &filter.bits[block * (bloomBlockBits / 64)];
+
+    // Double hashing picks the bit positions inside the block
+    uint32_t h1 = static_cast<uint32_t>(hash);
+    uint32_t h2 = static_cast<uint32_t>((hash * 0x9e3779b97f4a7c15ULL) >> 32) | 1;
+    for (int i = 0; i < filter.probes; i++)
+    {
+        uint32_t bit = (h1 + static_cast<uint32_t>(i) * h2) % bloomBlockBits;
+        bits[bit / 64] |= 1ULL << (bit % 64);
+    }
+}
+
+// Function to check if a word may be in the bloom filter
+// False means the word is definitely not in the dictionary
+bool bloomMayContain(const BloomFilter &filter, const string &word)
+{
+    // An empty filter holds nothing
+    if (filter.blockCount == 0)
+    {
+        return false;
+    }
+
+    // Same block and bit positions as bloomInsert
+    uint64_t hash = hashWord(word);
+    size_t block = static_cast<size_t>(((hash >> 32) * filter.blockCount) >> 32);
+    const uint64_t *bits = &filter.bits[block * (bloomBlockBits / 64)];
+    uint32_t h1 = static_cast<uint32_t>(hash);
+    uint32_t h2 = static_cast<uint32_t>((hash * 0x9e3779b97f4a7c15ULL) >> 32) | 1;
+    for (int i = 0; i < filter.probes; i++)
+    {
+        uint32_t bit = (h1 + static_cast<uint32_t>(i) * h2) % bloomBlockBits;
+        if ((bits[bit / 64] & (1ULL << (bit % 64))) == 0)
+        {
+            return false;
+        }
+    }
+
+    // Every probed bit is set
+    return true;
+}
+
+// Function to build the lookup indexes from the loaded words
+// Touches nothing but index, so a new dictionary can be built on
+// another thread while the game reads the current one
+void buildDictionaryIndex(DictionaryIndex &index, const WordStore &words)
+{
+    // Size the bloom filter for the current word count
+    size_t wordCount = wordStoreSize(words);
+    buildBloomFilter(index.bloom, wordCount, bloomFalsePositiveRate);
+    index.words = &words;
+
+    // The succinct backend spells its words out once for the build
+    vector<string> expanded;
+    if (words.backend == WordBackend::Succinct)
+    {
+        expanded.reserve(wordCount);
+        for (size_t i = 0; i < wordCount; i++)
+        {
+            expanded.push_back(wordAt(words, static_cast<uint32_t>(i)));
+        }
+    }
+    const vector<string> &text = words.backend == WordBackend::Succinct ? expanded : words.strings;
+
+    // Hash every word once, remembering where it came from
+    vector<pair<uint64_t, uint32_t>> hashed(wordCount);
+    for (size_t i = 0; i < wordCount; i++)
+    {
+        bloomInsert(index.bloom, text[i]);
+        hashed[i] = make_pair(hashWord(text[i]), static_cast<uint32_t>(i));
+    }
+
+    // Letter histograms for anagram checks and dictionary scans
+    index.histograms.resize(wordCount);
+    computeHistograms(text, index.histograms.data());
+
+    // Set of letters in every word
+    index.letterMasks.resize(wordCount);
+    for (size_t i = 0; i < wordCount; i++)
+    {
+        index.letterMasks[i] = letterMaskOf(text[i]);
+    }
+
+    // Word IDs in length order
+    buildLengthOrder(index, words);
+
+    // Ladder, grid, bee, hangman, pattern and wordle indexes
+    buildModeIndexes(index, text);
+
+    // The succinct backend looks up IDs through its trie
+    index.wordHash = PerfectHash();
+    index.slotToId.clear();
+    index.collidingIds.clear();
+    index.overflowIds.clear();
+    if (words.backend == WordBackend::Strings)
+    {
+        buildWordIdHash(index, text, hashed);
+    }
+
+    // Map the frequency table
+    loadFrequencyTable(index, text, frequencyFile);
+}
+
+// Function to build the word to ID table for the Strings backend
+// Duplicate words are dropped, keeping the first ID. A word whose
+// hash another word already has goes to the spelling-keyed overflow
+// table instead, so no word loses its ID to a collision
+void buildWordIdHash(DictionaryIndex &index, const vector<string> &text, vector<pair<uint64_t, uint32_t>> &hashed)
+{
+    // Order by hash, then spelling; stable, so duplicates stay in ID
+    // order
+    stable_sort(hashed.begin(), hashed.end(), [&text](const pair<uint64_t, uint32_t> &a, const pair<uint64_t, uint32_t> &b)
+                { return a.first != b.first ? a.first < b.first : text[a.second] < text[b.second]; });
+    hashed.erase(unique(hashed.begin(), hashed.end(), [&text](const pair<uint64_t, uint32_t> &a, const pair<uint64_t, uint32_t> &b)
+                        { return a.first == b.first && text[a.second] == text[b.second]; }),
+                 hashed.end());
+
+    // The first word of each hash takes a perfect hash key
+    vector<uint64_t> keyHashes;
+    keyHashes.reserve(hashed.size());
+    for (size_t i = 0; i < hashed.size(); i++)
+    {
+        if (i > 0 && hashed[i].first == hashed[i - 1].first)
+        {
+            index.collidingIds.push_back(hashed[i].second);
+            index.overflowIds.emplace(text[hashed[i].second], hashed[i].second);
+        }
+        else
+        {
+            keyHashes.push_back(hashed[i].first);
+        }
+    }
+    buildPerfectHash(index.wordHash, keyHashes);
+
+    // Record which word ID owns each slot
+    index.slotToId.assign(index.wordHash.keyCount, noWordId);
+    for (size_t i = 0; i < hashed.size(); i++)
+    {
+        size_t slot = perfectHashLookup(index.wordHash, hashed[i].first);
+        if (slot < index.slotToId.size() && (i == 0 || hashed[i].first != hashed[i - 1].first))
+        {
+            index.slotToId[slot] = hashed[i].second;
+        }
+    }
+}
+
+// Function to check if a word is in the dictionary
+bool isDictionaryWord(const string &word)
+{
+    // Most non-words stop at the bloom filter
+    if (!bloomMayContain(dictionaryIndex.bloom, word))
+    {
+        return false;
+    }
+
+    // Confirm with the exact lookup
+    return findWordId(word) != noWordId;
+}
+
+// Function to check if a guess uses exactly the letters of a word
+bool isAnagramOf(const string &guess, uint32_t wordId)
+{
+    // Compare letter histograms
+    return histogramsEqual(computeHistogram(guess), dictionaryIndex.histograms[wordId]);
+}
+
+// Function to rehash a key for one perfect hash level
+uint64_t mixHash(uint64_t hash, uint64_t seed)
+{
+    // Murmur-style finalizer over the key and level seed
+    hash ^= seed * 0x9e3779b97f4a7c15ULL;
+    hash ^= hash >> 31;
+    hash *= 0x7fb5d329728ea185ULL;
+    hash ^= hash >> 27;
+    hash *= 0x81dadef4bc2dd44dULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+// Function to build a minimal perfect hash over distinct key hashes
+void buildPerfectHash(PerfectHash &table, const vector<uint64_t> &keyHashes)
+{
+    // Start from an empty table
+    table.bits.clear();
+    table.levelOffsets.clear();
+    table.rankSamples.clear();
+    table.keyCount = 0;
+
+    // Keys still waiting for a slot
+    vector<uint64_t> remaining = keyHashes;
+    uint64_t offset = 0;
+
+    // Place keys level by level until every key has a slot
+    for (uint64_t level = 0; !remaining.empty(); level++)
+    {
+        // Level size in bits, rounded to whole rank blocks
+        uint64_t levelBits = static_cast<uint64_t>(static_cast<double>(remaining.size()) * perfectHashGamma);
+        levelBits = max<uint64_t>(rankBlockBits, (levelBits + rankBlockBits - 1) / rankBlockBits * rankBlockBits);
+
+        // Mark positions hit once and positions hit more than once
+        vector<uint64_t> hit(levelBits / 64, 0);
+        vector<uint64_t> collision(levelBits / 64, 0);
+        for (uint64_t key : remaining)
+        {
+            uint64_t pos = mixHash(key, level) % levelBits;
+            uint64_t mask = 1ULL << (pos % 64);
+            if (hit[pos / 64] & mask)
+            {
+                collision[pos / 64] |= mask;
+            }
+            hit[pos / 64] |= mask;
+        }
+
+        // Keep only positions with a single key
+        for (size_t w = 0; w < hit.size(); w++)
+        {
+            hit[w] &= ~collision[w];
+        }
+
+        // Colliding keys move on to the next level
+        vector<uint64_t> next;
+        for (uint64_t key : remaining)
+        {
+            uint64_t pos = mixHash(key, level) % levelBits;
+            if ((hit[pos / 64] & (1ULL << (pos % 64))) == 0)
+            {
+                next.push_back(key);
+            }
+        }
+
+        // Identical keys collide on every level; once a level places
+        // nothing, drop the repeats so the rest can't loop forever
+        table.keyCount += remaining.size() - next.size();
+        if (next.size() == remaining.size())
+        {
+            sort(next.begin(), next.end());
+            next.erase(unique(next.begin(), next.end()), next.end());
+        }
+
+        // Append the level
+        table.levelOffsets.push_back(offset);
+        table.bits.insert(table.bits.end(), hit.begin(), hit.end());
+        offset += levelBits;
+        remaining.swap(next);
+    }
+
+    // Mark the end of the last level
+    table.levelOffsets.push_back(offset);
+
+    // Precompute rank samples
+    buildRankSamples(table.bits, table.rankSamples);
+}
+
+// Function to find the slot of a key in the perfect hash
+// Keys that were not in the build set land on an arbitrary slot or none
+size_t perfectHashLookup(const PerfectHash &table, uint64_t keyHash)
+{
+    // Walk the levels until the key's bit is set
+    for (size_t level = 0; level + 1 < table.levelOffsets.size(); level++)
+    {
+        uint64_t levelBits = table.levelOffsets[level + 1] - table.levelOffsets[level];
+        uint64_t pos = table.levelOffsets[level] + mixHash(keyHash, level) % levelBits;
+        if (table.bits[pos / 64] & (1ULL << (pos % 64)))
+        {
+            // The slot is the number of set bits before this one
+            return rankOnes(table.bits, table.rankSamples, pos);
+        }
+    }
+
+    // Key is not in the table
+    return table.keyCount;
+}
+
+// Function to get the ID of a dictionary word
+// Returns noWordId if the word is not loaded
+uint32_t findWordId(const string &word)
+{
+    // The succinct backend answers directly from its trie
+    if (dictionaryIndex.words->backend == WordBackend::Succinct)
+    {
+        return trieWordId(*dictionaryIndex.words, word);
+    }
+
+    // Find the slot for the word
+    uint64_t hash = hashWord(word);
+    size_t slot = perfectHashLookup(dictionaryIndex.wordHash, hash);
+
+    // The perfect hash maps unknown words somewhere too, so compare
+    if (slot < dictionaryIndex.slotToId.size() && dictionaryIndex.slotToId[slot] != noWordId &&
+        dictionaryIndex.words->strings[dictionaryIndex.slotToId[slot]] == word)
+    {
+        return dictionaryIndex.slotToId[slot];
+    }
+
+    // Colliding words, and words from packs merged in since the
+    // perfect hash was built
+    auto overflow = dictionaryIndex.overflowIds.find(word);
+    if (overflow != dictionaryIndex.overflowIds.end())
+    {
+        return overflow->second;
+    }
+    return noWordId;
+}
+
+// Function to get the word stored under an ID
+string wordOf(uint32_t wordId)
+{
+    // IDs are positions in the loaded word store
+    return wordAt(*dictionaryIndex.words, wordId);
+}
+
+// Function to precompute rank samples for a bit array
+// Each sample holds the number of set bits before its 512-bit block
+void buildRankSamples(const vector<uint64_t> &bits, vector<uint32_t> &samples)
+{
+    // Walk the words, sampling at every block start
+    samples.clear();
+    uint32_t running = 0;
+    for (size_t w = 0; w < bits.size(); w++)
+    {
+        if (w % (rankBlockBits / 64) == 0)
+        {
+            samples.push_back(running);
+        }
+        running += static_cast<uint32_t>(__builtin_popcountll(bits[w]));
+    }
+
+    // Closing sample so selects can bound their search
+    samples.push_back(running);
+}
+
+// Function to count set bits before a position
+size_t rankOnes(const vector<uint64_t> &bits, const vector<uint32_t> &samples, size_t pos)
+{
+    // Sampled count plus the full words and the partial word
+    size_t rank = samples[pos / rankBlockBits];
+    for (size_t w = pos / rankBlockBits * (rankBlockBits / 64); w < pos / 64; w++)
+    {
+        rank += static_cast<size_t>(__builtin_popcountll(bits[w]));
+    }
+    if (pos % 64 != 0)
+    {
+        rank += static_cast<size_t>(__builtin_popcountll(bits[pos / 64] & ((1ULL << (pos % 64)) - 1)));
+    }
+    return rank;
+}
+
+// Function to find the position of the k-th set bit (k starts at 1)
+size_t selectOne(const vector<uint64_t> &bits, const vector<uint32_t> &samples, size_t k)
+{
+    // Binary search for the last block with fewer than k bits before it
+    size_t lo = 0;
+    size_t hi = samples.size() - 1;
+    while (hi - lo > 1)
+    {
+        size_t mid = (lo + hi) / 2;
+        if (samples[mid] < k)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    // Scan the block word by word
+    size_t remaining = k - samples[lo];
+    size_t w = lo * (rankBlockBits / 64);
+    while (true)
+    {
+        size_t count = static_cast<size_t>(__builtin_popcountll(bits[w]));
+        if (remaining <= count)
+        {
+            break;
+        }
+        remaining -= count;
+        w++;
+    }
+
+    // Drop lower set bits until the wanted one is lowest
+    uint64_t word = bits[w];
+    for (size_t i = 1; i < remaining; i++)
+    {
+        word &= word - 1;
+    }
+    return w * 64 + static_cast<size_t>(__builtin_ctzll(word));
+}
+
+// Function to find the position of the k-th clear bit (k starts at 1)
+size_t selectZero(const vector<uint64_t> &bits, const vector<uint32_t> &samples, size_t k)
+{
+    // Binary search on the clear bits before each block
+    size_t lo = 0;
+    size_t hi = samples.size() - 1;
+    while (hi - lo > 1)
+    {
+        size_t mid = (lo + hi) / 2;
+        if (mid * rankBlockBits - samples[mid] < k)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    // Scan the block word by word
+    size_t remaining = k - (lo * rankBlockBits - samples[lo]);
+    size_t w = lo * (rankBlockBits / 64);
+    while (true)
+    {
+        size_t count = 64 - static_cast<size_t>(__builtin_popcountll(bits[w]));
+        if (remaining <= count)
+        {
+            break;
+        }
+        remaining -= count;
+        w++;
+    }
+
+    // Same as selectOne on the inverted word
+    uint64_t word = ~bits[w];
+    for (size_t i = 1; i < remaining; i++)
+    {
+        word &= word - 1;
+    }
+    return w * 64 + static_cast<size_t>(__builtin_ctzll(word));
+}
+
+// Function to build a LOUDS trie from sorted, distinct words
+// wordNodes receives the node where each input word ends
+void buildLoudsTrie(LoudsTrie &trie, const vector<string> &sortedWords, vector<size_t> &wordNodes)
+{
+    // Define a range of words sharing a prefix of the given depth
+    struct NodeRange
+    {
+        size_t lo;
+        size_t hi;
+        size_t depth;
+    };
+
+    // Start from an empty trie with the "10" super-root
+    trie = LoudsTrie();
+    vector<bool> shapeBits = {true, false};
+    vector<bool> terminalBits;
+    wordNodes.assign(sortedWords.size(), noNode);
+
+    // Breadth-first queue; a node's number is its position in the queue
+    vector<NodeRange> queue;
+    queue.push_back({0, sortedWords.size(), 0});
+    trie.labels.push_back('\0');
+    for (size_t node = 0; node < queue.size(); node++)
+    {
+        NodeRange range = queue[node];
+
+        // Sorted order puts a word equal to the prefix first
+        bool isTerminal = range.lo < range.hi && sortedWords[range.lo].length() == range.depth;
+        terminalBits.push_back(isTerminal);
+        if (isTerminal)
+        {
+            wordNodes[range.lo] = node;
+            range.lo++;
+        }
+
+        // One child per distinct next letter
+        size_t i = range.lo;
+        while (i < range.hi)
+        {
+            char letter = sortedWords[i][range.depth];
+            size_t j = i;
+            while (j < range.hi && sortedWords[j][range.depth] == letter)
+            {
+                j++;
+            }
+            queue.push_back({i, j, range.depth + 1});
+            trie.labels.push_back(letter);
+            shapeBits.push_back(true);
+            i = j;
+        }
+        shapeBits.push_back(false);
+    }
+    trie.nodeCount = queue.size();
+
+    // Pack the bits into words
+    trie.shape.assign((shapeBits.size() + 63) / 64, 0);
+    for (size_t b = 0; b < shapeBits.size(); b++)
+    {
+        if (shapeBits[b])
+        {
+            trie.shape[b / 64] |= 1ULL << (b % 64);
+        }
+    }
+    trie.terminal.assign((terminalBits.size() + 63) / 64, 0);
+    for (size_t b = 0; b < terminalBits.size(); b++)
+    {
+        if (terminalBits[b])
+        {
+            trie.terminal[b / 64] |= 1ULL << (b % 64);
+        }
+    }
+
+    // Rank samples for navigation and terminal ranks
+    buildRankSamples(trie.shape, trie.shapeRanks);
+    buildRankSamples(trie.terminal, trie.terminalRanks);
+}
+
+// Function to follow the edge with a letter out of a trie node
+// Returns noNode if there is no such child
+size_t loudsChild(const LoudsTrie &trie, size_t node, char letter)
+{
+    // The node's 1 bits sit between its zero and the next one
+    size_t start = selectZero(trie.shape, trie.shapeRanks, node + 1) + 1;
+    size_t end = selectZero(trie.shape, trie.shapeRanks, node + 2);
+
+    // The 1 bit at position p belongs to node p - node - 1
+    size_t lo = start - node - 1;
+    size_t hi = end - node - 1;
+
+    // Children are in letter order, so binary search the labels
+    unsigned char target = static_cast<unsigned char>(letter);
+    while (lo < hi)
+    {
+        size_t mid = (lo + hi) / 2;
+        if (static_cast<unsigned char>(trie.labels[mid]) < target)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    if (lo < end - node - 1 && trie.labels[lo] == letter)
+    {
+        return lo;
+    }
+    return noNode;
+}
+
+// Function to go from a trie node to its parent
+size_t loudsParent(const LoudsTrie &trie, size_t node)
+{
+    // The node's 1 bit lies in its parent's block
+    size_t pos = selectOne(trie.shape, trie.shapeRanks, node + 1);
+    return pos - node - 1;
+}
+
+// Function to find the node spelling a string
+// Returns noNode if no word starts with it
+size_t loudsFind(const LoudsTrie &trie, const string &word)
+{
+    // An empty trie holds nothing
+    if (trie.nodeCount == 0)
+    {
+        return noNode;
+    }
+
+    // Follow one edge per letter from the root
+    size_t node = 0;
+    for (char letter : word)
+    {
+        node = loudsChild(trie, node, letter);
+        if (node == noNode)
+        {
+            break;
+        }
+    }
+    return node;
+}
+
+// Function to check if a trie node ends a word
+bool loudsIsTerminal(const LoudsTrie &trie, size_t node)
+{
+    return (trie.terminal[node / 64] >> (node % 64)) & 1;
+}
+
+// Function to count the words in a store
+size_t wordStoreSize(const WordStore &words)
+{
+    // Both backends keep a length per word
+    return words.lengths.size();
+}
+
+// Function to add words to the end of a store
+// New words get the next IDs in order. The Succinct backend first sorts
+// the new words and drops repeats, leaving newWords in that order, and
+// builds one more trie from them alone, so earlier words keep their
+// tries and IDs
+void appendWords(WordStore &words, vector<string> &newWords)
+{
+    // Succinct IDs follow trie order
+    if (words.backend == WordBackend::Succinct)
+    {
+        sort(newWords.begin(), newWords.end());
+        newWords.erase(unique(newWords.begin(), newWords.end()), newWords.end());
+    }
+
+    // Record the lengths, capped to fit a byte
+    for (const string &word : newWords)
+    {
+        words.lengths.push_back(static_cast<uint8_t>(min<size_t>(word.length(), 255)));
+    }
+
+    // Strings backend just keeps the strings
+    if (words.backend == WordBackend::Strings)
+    {
+        words.strings.insert(words.strings.end(), newWords.begin(), newWords.end());
+        return;
+    }
+
+    // One trie over the new words; its k-th terminal is the k-th word
+    if (!newWords.empty())
+    {
+        vector<size_t> wordNodes;
+        words.trieStarts.push_back(static_cast<uint32_t>(words.lengths.size() - newWords.size()));
+        words.tries.emplace_back();
+        buildLoudsTrie(words.tries.back(), newWords, wordNodes);
+    }
+}
+
+// Function to find the trie holding a word ID (Succinct backend)
+size_t trieOf(const WordStore &words, uint32_t wordId)
+{
+    // Last trie starting at or before the ID
+    return static_cast<size_t>(upper_bound(words.trieStarts.begin(), words.trieStarts.end(), wordId) - words.trieStarts.begin()) - 1;
+}
+
+// Function to get the word stored under an ID
+string wordAt(const WordStore &words, uint32_t wordId)
+{
+    // Strings backend stores it directly
+    if (words.backend == WordBackend::Strings)
+    {
+        return words.strings[wordId];
+    }
+
+    // The word ends on its trie's terminal of the same rank
+    size_t t = trieOf(words, wordId);
+    const LoudsTrie &trie = words.tries[t];
+    size_t node = selectOne(trie.terminal, trie.terminalRanks, wordId - words.trieStarts[t] + 1);
+
+    // Walk from the word's node up to the root collecting letters
+    string word;
+    while (node != 0)
+    {
+        word.push_back(trie.labels[node]);
+        node = loudsParent(trie, node);
+    }
+    reverse(word.begin(), word.end());
+    return word;
+}
+
+// Function to get a word's ID through the succinct tries
+// Tries are searched oldest first, so a repeated word gets its lowest ID
+uint32_t trieWordId(const WordStore &words, const string &word)
+{
+    for (size_t t = 0; t < words.tries.size(); t++)
+    {
+        // The word must end on a terminal node, whose rank gives the ID
+        const LoudsTrie &trie = words.tries[t];
+        size_t node = loudsFind(trie, word);
+        if (node != noNode && loudsIsTerminal(trie, node))
+        {
+            return words.trieStarts[t] + static_cast<uint32_t>(rankOnes(trie.terminal, trie.terminalRanks, node));
+        }
+    }
+    return noWordId;
+}
+
+// Function to measure the memory a store holds its words in
+// Counts the backend's arrays and string buffers, not allocator overhead
+size_t wordStoreBytes(const WordStore &words)
+{
+    size_t bytes = words.lengths.size() + words.trieStarts.size() * sizeof(uint32_t);
+    for (const string &word : words.strings)
+    {
+        bytes += sizeof(string) + (word.capacity() > 15 ? word.capacity() + 1 : 0);
+    }
+    for (const LoudsTrie &trie : words.tries)
+    {
+        bytes += (trie.shape.size() + trie.terminal.size()) * sizeof(uint64_t) +
+                 (trie.shapeRanks.size() + trie.terminalRanks.size()) * sizeof(uint32_t) + trie.labels.size();
+    }
+    return bytes;
+}
+
+// Function to list the IDs of words starting with a prefix
+// Stops after limit words
+void findWordsWithPrefix(const WordStore &words, const string &prefix, vector<uint32_t> &wordIds, size_t limit)
+{
+    // Start from an empty list
+    wordIds.clear();
+
+    // Strings backend has no prefix structure, so scan
+    if (words.backend == WordBackend::Strings)
+    {
+        for (size_t i = 0; i < words.strings.size() && wordIds.size() < limit; i++)
+        {
+            if (words.strings[i].compare(0, prefix.length(), prefix) == 0)
+            {
+                wordIds.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        return;
+    }
+
+    // In each trie, find the prefix node, then walk its subtree
+    // depth-first
+    vector<size_t> stack;
+    for (size_t t = 0; t < words.tries.size() && wordIds.size() < limit; t++)
+    {
+        const LoudsTrie &trie = words.tries[t];
+        size_t root = loudsFind(trie, prefix);
+        if (root == noNode)
+        {
+            continue;
+        }
+        stack.assign(1, root);
+        while (!stack.empty() && wordIds.size() < limit)
+        {
+            size_t node = stack.back();
+            stack.pop_back();
+            if (loudsIsTerminal(trie, node))
+            {
+                wordIds.push_back(words.trieStarts[t] + static_cast<uint32_t>(rankOnes(trie.terminal, trie.terminalRanks, node)));
+            }
+
+            // Push children in reverse so they pop in letter order
+            size_t start = selectZero(trie.shape, trie.shapeRanks, node + 1) + 1;
+            size_t end = selectZero(trie.shape, trie.shapeRanks, node + 2);
+            for (size_t child = end - node - 1; child > start - node - 1; child--)
+            {
+                stack.push_back(child - 1);
+            }
+        }
+    }
+}
+
+// Function to check once whether the CPU supports AVX2
+bool cpuHasAvx2()
+{
+#ifdef UNSCRAMBLE_X86_SIMD
+    // Ask the CPU the first time only
+    static const bool supported = []()
+    {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+    return supported;
+#else
+    // No x86 SIMD on this platform
+    return false;
+#endif
+}
+
+// Function to count the letters of a word
+LetterHistogram computeHistogram(const string &word)
+{
+    // Start with every bucket empty
+    LetterHistogram histogram = {};
+
+    // Letters go to their own bucket, anything else to bucket 26
+    for (char c : word)
+    {
+        unsigned bucket = static_cast<unsigned>(c - 'a');
+        histogram.counts[bucket < 26 ? bucket : 26]++;
+    }
+    return histogram;
+}
+
+// Function to check if two histograms are the same
+// The fixed 32-byte compare compiles to a couple of vector instructions
+bool histogramsEqual(const LetterHistogram &a, const LetterHistogram &b)
+{
+    return memcmp(a.counts, b.counts, sizeof(a.counts)) == 0;
+}
+
+// Function to check if every count in inner fits within outer
+// True when inner's word can be spelled from outer's letters
+bool histogramContains(const LetterHistogram &outer, const LetterHistogram &inner)
+{
+    // Branch-free so the compiler can vectorize it
+    bool fits = true;
+    for (size_t i = 0; i < sizeof(outer.counts); i++)
+    {
+        fits &= inner.counts[i] <= outer.counts[i];
+    }
+    return fits;
+}
+
+#ifdef UNSCRAMBLE_X86_SIMD
+// AVX2 kernel: IDs of histograms equal to a target
+__attribute__((target("avx2"))) void findEqualHistogramsAvx2(const vector<LetterHistogram> &histograms, const LetterHistogram &target, vector<uint32_t> &wordIds)
+{
+    __m256i want = _mm256_load_si256(reinterpret_cast<const __m256i *>(target.counts));
+    for (size_t i = 0; i < histograms.size(); i++)
+    {
+        __m256i have = _mm256_load_si256(reinterpret_cast<const __m256i *>(histograms[i].counts));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(have, want)) == -1)
+        {
+            wordIds.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+// AVX2 kernel: IDs of histograms that fit within an outer histogram
+// inner <= outer in every byte exactly when max(inner, outer) == outer
+__attribute__((target("avx2"))) void findContainedHistogramsAvx2(const vector<LetterHistogram> &histograms, const LetterHistogram &outer, vector<uint32_t> &wordIds)
+{
+    __m256i limit = _mm256_load_si256(reinterpret_cast<const __m256i *>(outer.counts));
+    for (size_t i = 0; i < histograms.size(); i++)
+    {
+        __m256i have = _mm256_load_si256(reinterpret_cast<const __m256i *>(histograms[i].counts));
+        __m256i fits = _mm256_cmpeq_epi8(_mm256_max_epu8(have, limit), limit);
+        if (_mm256_movemask_epi8(fits) == -1)
+        {
+            wordIds.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+#endif
+
+// Function to count the letters of many words
+// Counting is bound by walking the letters; a compare-per-letter AVX2
+// version measured about half this speed, so building stays scalar
+void computeHistograms(const vector<string> &words, LetterHistogram *out)
+{
+    // One counting pass per word
+    for (size_t i = 0; i < words.size(); i++)
+    {
+        out[i] = computeHistogram(words[i]);
+    }
+}
+
+// Function to list the IDs of words with exactly the target's letters
+void findEqualHistograms(const vector<LetterHistogram> &histograms, const LetterHistogram &target, vector<uint32_t> &wordIds)
+{
+    // Start from an empty list
+    wordIds.clear();
+
+#ifdef UNSCRAMBLE_X86_SIMD
+    // Vector kernel when the CPU has it
+    if (cpuHasAvx2())
+    {
+        findEqualHistogramsAvx2(histograms, target, wordIds);
+        return;
+    }
+#endif
+
+    // Scalar fallback
+    for (size_t i = 0; i < histograms.size(); i++)
+    {
+        if (histogramsEqual(histograms[i], target))
+        {
+            wordIds.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+// Function to list the IDs of words spelled from a subset of outer's letters
+void findContainedHistograms(const vector<LetterHistogram> &histograms, const LetterHistogram &outer, vector<uint32_t> &wordIds)
+{
+    // Start from an empty list
+    wordIds.clear();
+
+#ifdef UNSCRAMBLE_X86_SIMD
+    // Vector kernel when the CPU has it
+    if (cpuHasAvx2())
+    {
+        findContainedHistogramsAvx2(histograms, outer, wordIds);
+        return;
+    }
+#endif
+
+    // Scalar fallback
+    for (size_t i = 0; i < histograms.size(); i++)
+    {
+        if (histogramContains(outer, histograms[i]))
+        {
+            wordIds.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+// Function to list every dictionary word made from a word's letters
+void findAnagrams(uint32_t wordId, vector<uint32_t> &wordIds)
+{
+    // One pass over all histograms
+    findEqualHistograms(dictionaryIndex.histograms, dictionaryIndex.histograms[wordId], wordIds);
+}
+
+// Function to time the histogram kernels against plain scalar loops
+// Run with: cis17c_project1 --bench
+void runBenchmarks()
+{
+    // Fixed seed so runs are comparable
+    srand(12345);
+
+    // One million random words of 3 to 12 letters
+    const size_t benchWords = 1000000;
+    vector<string> words(benchWords);
+    for (string &word : words)
+    {
+        size_t length = 3 + static_cast<size_t>(rand()) % 10;
+        for (size_t i = 0; i < length; i++)
+        {
+            word.push_back(static_cast<char>('a' + rand() % 26));
+        }
+    }
+    LetterHistogram target = computeHistogram(words[benchWords / 2]);
+
+    // Best of five runs, in milliseconds
+    auto timeIt = [](const auto &work)
+    {
+        double best = 1e30;
+        for (int run = 0; run < 5; run++)
+        {
+            auto start = chrono::steady_clock::now();
+            work();
+            best = min(best, chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+        }
+        return best;
+    };
+
+    // Histogram building
+    vector<LetterHistogram> scalar(benchWords);
+    vector<LetterHistogram> kernel(benchWords);
+    double scalarBuild = timeIt([&]()
+                                {
+        for (size_t i = 0; i < benchWords; i++)
+        {
+            LetterHistogram histogram = {};
+            for (char c : words[i])
+            {
+                histogram.counts[c - 'a']++;
+            }
+            scalar[i] = histogram;
+        } });
+    double kernelBuild = timeIt([&]()
+                                { computeHistograms(words, kernel.data()); });
+
+    // Anagram scan: byte-by-byte loop against the kernel
+    vector<uint32_t> found;
+    size_t scalarMatches = 0;
+    double scalarEqual = timeIt([&]()
+                                {
+        scalarMatches = 0;
+        for (size_t i = 0; i < benchWords; i++)
+        {
+            bool same = true;
+            for (int b = 0; b < 26 && same; b++)
+            {
+                same = scalar[i].counts[b] == target.counts[b];
+            }
+            scalarMatches += same;
+        } });
+    double kernelEqual = timeIt([&]()
+                                { findEqualHistograms(kernel, target, found); });
+    size_t kernelMatches = found.size();
+
+    // Sub-anagram scan
+    size_t scalarFits = 0;
+    double scalarContain = timeIt([&]()
+                                  {
+        scalarFits = 0;
+        for (size_t i = 0; i < benchWords; i++)
+        {
+            bool fits = true;
+            for (int b = 0; b < 26 && fits; b++)
+            {
+                fits = scalar[i].counts[b] <= target.counts[b];
+            }
+            scalarFits += fits;
+        } });
+    double kernelContain = timeIt([&]()
+                                  { findContainedHistograms(kernel, target, found); });
+
+    // Report
+    cout << fixed << setprecision(2);
+    cout << "Histogram kernels over " << benchWords << " words (AVX2 " << (cpuHasAvx2() ? "on" : "off") << ")\n";
+    cout << "  build     scalar " << scalarBuild << " ms  kernel " << kernelBuild << " ms  x" << scalarBuild / kernelBuild << "\n";
+    cout << "  anagram   scalar " << scalarEqual << " ms  kernel " << kernelEqual << " ms  x" << scalarEqual / kernelEqual
+         << "  (" << scalarMatches << "/" << kernelMatches << " matches)\n";
+    cout << "  contains  scalar " << scalarContain << " ms  kernel " << kernelContain << " ms  x" << scalarContain / kernelContain
+         << "  (" << scalarFits << "/" << found.size() << " matches)\n";
+
+    // Grid solver throughput on one core, using the bench words
+    WordStore benchStore;
+    appendWords(benchStore, words);
+    buildDictionaryIndex(dictionaryIndex, benchStore);
+    GridSearch search;
+    mt19937 rng(12345);
+    const int benchGrids = 5000;
+    size_t gridWords = 0;
+    auto start = chrono::steady_clock::now();
+    for (int g = 0; g < benchGrids; g++)
+    {
+        randomGrid(search.grid, rng);
+        solveGrid(search);
+        gridWords += search.found.size();
+    }
+    double gridSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "  grids     " << benchGrids / gridSeconds << " 5x5 grids/s on one core  ("
+         << static_cast<double>(gridWords) / benchGrids << " words per grid)\n";
+
+    // Bytes per word of both store backends over the bench words
+    WordStore succinctStore;
+    succinctStore.backend = WordBackend::Succinct;
+    vector<string> succinctWords = words;
+    appendWords(succinctStore, succinctWords);
+    cout << "  store     strings " << static_cast<double>(wordStoreBytes(benchStore)) / wordStoreSize(benchStore)
+         << " bytes/word  succinct " << static_cast<double>(wordStoreBytes(succinctStore)) / wordStoreSize(succinctStore)
+         << " bytes/word\n";
+
+    // Queries on both backends: the ID of a stored word (membership and
+    // ID at once, checked by reading the word back), random strings that
+    // are mostly not words, and the first words under 3-letter prefixes
+    const size_t benchLookups = 100000;
+    const size_t benchPrefixes = 1000;
+    const size_t prefixLimit = 50;
+    vector<string> misses(benchLookups);
+    for (string &miss : misses)
+    {
+        for (size_t i = 0; i < 7; i++)
+        {
+            miss.push_back(static_cast<char>('a' + rand() % 26));
+        }
+    }
+    array<size_t, 2> idFound = {};
+    array<size_t, 2> missFound = {};
+    array<size_t, 2> prefixWords = {};
+    array<double, 2> idTime = {};
+    array<double, 2> missTime = {};
+    array<double, 2> prefixTime = {};
+    for (int backend = 0; backend < 2; backend++)
+    {
+        const WordStore &store = backend == 0 ? benchStore : succinctStore;
+        auto lookup = [&](const string &word)
+        {
+            return backend == 0 ? findWordId(word) : trieWordId(store, word);
+        };
+        idTime[backend] = timeIt([&]()
+                                 {
+            idFound[backend] = 0;
+            for (size_t i = 0; i < benchLookups; i++)
+            {
+                const string &word = words[i * (benchWords / benchLookups)];
+                uint32_t id = lookup(word);
+                idFound[backend] += id != noWordId && wordAt(store, id) == word;
+            } });
+        missTime[backend] = timeIt([&]()
+                                   {
+            missFound[backend] = 0;
+            for (const string &miss : misses)
+            {
+                missFound[backend] += lookup(miss) != noWordId;
+            } });
+        prefixTime[backend] = timeIt([&]()
+                                     {
+            prefixWords[backend] = 0;
+            vector<uint32_t> prefixIds;
+            for (size_t i = 0; i < benchPrefixes; i++)
+            {
+                findWordsWithPrefix(store, words[i].substr(0, 3), prefixIds, prefixLimit);
+                prefixWords[backend] += prefixIds.size();
+            } });
+    }
+    cout << "  word ID   strings " << idTime[0] * 1e6 / benchLookups << " ns  succinct " << idTime[1] * 1e6 / benchLookups
+         << " ns per stored word  (" << idFound[0] << "/" << idFound[1] << " found)\n";
+    cout << "  miss      strings " << missTime[0] * 1e6 / benchLookups << " ns  succinct " << missTime[1] * 1e6 / benchLookups
+         << " ns per random string  (" << missFound[0] << "/" << missFound[1] << " words)\n";
+    cout << "  prefix    strings " << prefixTime[0] * 1e3 / benchPrefixes << " us  succinct " << prefixTime[1] * 1e3 / benchPrefixes
+         << " us per 3-letter prefix, up to " << prefixLimit << " words  (" << prefixWords[0] << "/" << prefixWords[1] << " words)\n";
+
+#ifdef UNSCRAMBLE_COUNT_ALLOCATIONS
+    // Heap allocations per classic round on the bench words: first the
+    // word pipeline alone (pick, scramble, compare a guess), after one
+    // warm-up pick sizes the pool
+    syncWordRatings(benchStore);
+    const int benchRounds = 1000;
+    vector<uint32_t> pool;
+    filterWordsByDifficulty(pool, benchStore, 2);
+    string guess = "qqqqq";
+    size_t pipelineMatches = 0;
+    uint64_t before = heapAllocations.load();
+    for (int round = 0; round < benchRounds; round++)
+    {
+        filterWordsByDifficulty(pool, benchStore, 2);
+        uint32_t wordId = pool[static_cast<size_t>(rand()) % pool.size()];
+        Word word = storedWord(benchStore, wordId);
+        Word scrambled = scrambleWord(word);
+        Word guessWord = makeWord(guess.data(), guess.length());
+        pipelineMatches += wordsEqual(guessWord, word) || wordsEqual(scrambled, word);
+    }
+    double pipelineAllocations = static_cast<double>(heapAllocations.load() - before) / benchRounds;
+
+    // Then whole playGame rounds, three wrong guesses each, read from a
+    // script with the output thrown away. Reviews are cleared so every
+    // round draws a fresh word
+    const int benchGames = 200;
+    string script;
+    for (int round = 0; round < benchGames; round++)
+    {
+        script += "qq\nqq\nqq\n\n";
+    }
+    istringstream input(script);
+    streambuf *keyboard = cin.rdbuf(input.rdbuf());
+    streambuf *screen = cout.rdbuf(nullptr);
+    int benchScore = 0;
+    int benchHighest = 0;
+    int benchStreak = 0;
+    int benchMaxStreak = 0;
+    before = heapAllocations.load();
+    for (int round = 0; round < benchGames; round++)
+    {
+        player.reviews.clear();
+        player.reviewSlots.clear();
+        playGame(benchScore, benchHighest, benchStreak, benchMaxStreak, benchStore, 2);
+    }
+    double roundAllocations = static_cast<double>(heapAllocations.load() - before) / benchGames;
+    cout.rdbuf(screen);
+    cin.rdbuf(keyboard);
+    cout << "  rounds    " << pipelineAllocations << " allocations per word pick and scramble  " << roundAllocations
+         << " per full round  (" << pipelineMatches << " matches)\n";
+#else
+    cout << "  rounds    build with -DUNSCRAMBLE_COUNT_ALLOCATIONS to count allocations per round\n";
+#endif
+}
+
+// Function to rank which letter positions make the best hints
+// Candidates are the dictionary words spelled with the scramble's
+// letters. Each (position, letter) pair gets a bitset over the
+// candidates, and the greedy order reveals first the position that
+// leaves the fewest candidates. Ties go to the position whose letter
+// is rarest there among all words of the same length
+HintPlan planHints(uint32_t wordId)
+{
+    HintPlan plan;
+    string word = wordOf(wordId);
+    size_t length = min<size_t>(word.length(), 64);
+
+    // Distinct words with the same letters
+    vector<uint32_t> anagramIds;
+    findAnagrams(wordId, anagramIds);
+    vector<string> candidates;
+    for (uint32_t id : anagramIds)
+    {
+        string candidate = wordOf(id);
+        if (find(candidates.begin(), candidates.end(), candidate) == candidates.end())
+        {
+            candidates.push_back(candidate);
+        }
+    }
+
+    // One bitset per (position, letter); bucket 26 holds non-letters
+    size_t blocks = (candidates.size() + 63) / 64;
+    vector<uint64_t> sets(length * 27 * blocks, 0);
+    for (size_t c = 0; c < candidates.size(); c++)
+    {
+        for (size_t p = 0; p < length; p++)
+        {
+            unsigned letter = static_cast<unsigned>(candidates[c][p] - 'a');
+            sets[(p * 27 + (letter < 26 ? letter : 26)) * blocks + c / 64] |= 1ULL << (c % 64);
+        }
+    }
+
+    // How many same-length words share the answer's letter at each
+    // position: one popcount of a positional bitset each
+    vector<size_t> sharedCounts(length, 0);
+    vector<uint32_t> unused;
+    for (size_t p = 0; p < length; p++)
+    {
+        string single(word.length(), '?');
+        single[p] = word[p];
+        sharedCounts[p] = findPatternWords(single, unused, 0);
+    }
+
+    // Greedily pick the position that narrows the candidates most
+    vector<uint64_t> remaining(blocks, ~0ULL);
+    uint64_t used = 0;
+    for (size_t step = 0; step < length; step++)
+    {
+        size_t best = length;
+        size_t bestLeft = 0;
+        for (size_t p = 0; p < length; p++)
+        {
+            if (used & (1ULL << p))
+            {
+                continue;
+            }
+            unsigned letter = static_cast<unsigned>(word[p] - 'a');
+            const uint64_t *set = &sets[(p * 27 + (letter < 26 ? letter : 26)) * blocks];
+            size_t left = 0;
+            for (size_t b = 0; b < blocks; b++)
+            {
+                left += static_cast<size_t>(__builtin_popcountll(remaining[b] & set[b]));
+            }
+            if (best == length || left < bestLeft || (left == bestLeft && sharedCounts[p] < sharedCounts[best]))
+            {
+                best = p;
+                bestLeft = left;
+            }
+        }
+
+        // Apply the reveal and continue from the narrowed set
+        unsigned letter = static_cast<unsigned>(word[best] - 'a');
+        const uint64_t *set = &sets[(best * 27 + (letter < 26 ? letter : 26)) * blocks];
+        for (size_t b = 0; b < blocks; b++)
+        {
+            remaining[b] &= set[b];
+        }
+        used |= 1ULL << best;
+        plan.order.push_back(best);
+    }
+    return plan;
+}
+
+// Function to serve the next letter hint from a plan
+// Returns a position past the end when nothing is left to reveal
+size_t nextHintPosition(HintPlan &plan)
+{
+    // First planned position the player has not seen
+    for (size_t position : plan.order)
+    {
+        if ((plan.revealed & (1ULL << position)) == 0)
+        {
+            plan.revealed |= 1ULL << position;
+            return position;
+        }
+    }
+    return static_cast<size_t>(-1);
+}
+
+// Function to display the extra game modes
+void displayModesMenu()
+{
+    cout << "\nGame Modes:\n";
+    cout << "1. Word Ladder\n";
+    cout << "2. Letter Grid\n";
+    cout << "3. Spelling Bee\n";
+    cout << "4. Wordle\n";
+    cout << "5. Evil Hangman\n";
+    cout << "6. Fill the Blanks\n";
+    cout << "7. Phrase Jumble\n";
+    cout << "8. Daily Challenge\n";
+    cout << "9. Back to main menu\n";
+    cout << "Enter your choice: ";
+}
+
+// Function to let the player pick and play an extra game mode
+void playGameModes(int &score, int &highestScore)
+{
+    // Bring the mode indexes up to date with any packs bought
+    refreshModeIndexes();
+
+    // Display the modes menu
+    displayModesMenu();
+
+    // Get the player's choice
+    int mode;
+    cin >> mode;
+
+    // Start the chosen mode
+    if (mode == 1)
+    {
+        playWordLadder(score, highestScore);
+    }
+    else if (mode == 2)
+    {
+        playLetterGrid(score, highestScore);
+    }
+    else if (mode == 3)
+    {
+        playSpellingBee(score, highestScore);
+    }
+    else if (mode == 4)
+    {
+        playWordle(score, highestScore);
+    }
+    else if (mode == 5)
+    {
+        playEvilHangman(score, highestScore);
+    }
+    else if (mode == 6)
+    {
+        playFillTheBlanks(score, highestScore);
+    }
+    else if (mode == 7)
+    {
+        playPhraseJumble(score, highestScore);
+    }
+    else if (mode == 8)
+    {
+        playDailyChallenge(score, highestScore);
+    }
+    else if (mode != 9)
+    {
+        cout << "Invalid mode choice.\n";
+    }
+}
+
+// Function to hash the wildcard bucket of a word at one position
+// Same as hashing the word with '?' in that position
+uint64_t ladderBucketKey(const string &word, size_t position)
+{
+    // FNV-1a with the wildcard swapped in
+    uint64_t hash = 1469598103934665603ULL;
+    for (size_t i = 0; i < word.length(); i++)
+    {
+        hash ^= static_cast<unsigned char>(i == position ? '?' : word[i]);
+        hash *= 1099511628211ULL;
+    }
+
+    // Final mix so nearby patterns spread out
+    return mixHash(hash, word.length());
+}
+
+// Function to build the wildcard buckets for word ladders
+void buildLadderIndex(LadderIndex &ladder, const vector<string> &text)
+{
+    // Keep one ID per distinct lowercase word
+    vector<pair<uint64_t, uint32_t>> byHash(text.size());
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        byHash[i] = make_pair(hashWord(text[i]), static_cast<uint32_t>(i));
+    }
+    sort(byHash.begin(), byHash.end());
+
+    // One entry per (bucket, word)
+    vector<pair<uint64_t, uint32_t>> entries;
+    for (size_t i = 0; i < byHash.size(); i++)
+    {
+        if (i > 0 && byHash[i].first == byHash[i - 1].first)
+        {
+            continue;
+        }
+        const string &word = text[byHash[i].second];
+        if (!all_of(word.begin(), word.end(), [](char c)
+                    { return c >= 'a' && c <= 'z'; }))
+        {
+            continue;
+        }
+        for (size_t p = 0; p < word.length(); p++)
+        {
+            entries.push_back(make_pair(ladderBucketKey(word, p), byHash[i].second));
+        }
+    }
+    sort(entries.begin(), entries.end());
+
+    // Pack buckets holding at least two words
+    ladder = LadderIndex();
+    size_t i = 0;
+    while (i < entries.size())
+    {
+        size_t j = i;
+        while (j < entries.size() && entries[j].first == entries[i].first)
+        {
+            j++;
+        }
+        if (j - i > 1)
+        {
+            ladder.keys.push_back(entries[i].first);
+            ladder.starts.push_back(static_cast<uint32_t>(ladder.wordIds.size()));
+            for (size_t k = i; k < j; k++)
+            {
+                ladder.wordIds.push_back(entries[k].second);
+            }
+        }
+        i = j;
+    }
+    ladder.starts.push_back(static_cast<uint32_t>(ladder.wordIds.size()));
+}
+
+// Function to list the words one letter away from a word
+void ladderNeighbors(uint32_t wordId, vector<uint32_t> &neighbors)
+{
+    // Start from an empty list
+    neighbors.clear();
+    const LadderIndex &ladder = dictionaryIndex.ladder;
+    string word = wordOf(wordId);
+
+    // Every other word in each of the word's buckets
+    for (size_t p = 0; p < word.length(); p++)
+    {
+        uint64_t key = ladderBucketKey(word, p);
+        auto found = lower_bound(ladder.keys.begin(), ladder.keys.end(), key);
+        if (found == ladder.keys.end() || *found != key)
+        {
+            continue;
+        }
+        size_t bucket = static_cast<size_t>(found - ladder.keys.begin());
+        for (uint32_t k = ladder.starts[bucket]; k < ladder.starts[bucket + 1]; k++)
+        {
+            if (ladder.wordIds[k] != wordId)
+            {
+                neighbors.push_back(ladder.wordIds[k]);
+            }
+        }
+    }
+}
+
+// Function to find a shortest ladder between two words
+// Bidirectional BFS: grow whichever side has the smaller frontier,
+// one full layer at a time, until the two searches touch.
+// Returns the number of steps, or -1 if none within maxSteps
+int findLadder(uint32_t fromId, uint32_t toId, int maxSteps, vector<uint32_t> &path)
+{
+    // Same word needs no steps
+    path.clear();
+    if (fromId == toId)
+    {
+        path.push_back(fromId);
+        return 0;
+    }
+
+    // Parent and depth of every word each side has reached
+    unordered_map<uint32_t, pair<uint32_t, int>> seenFrom = {{fromId, {fromId, 0}}};
+    unordered_map<uint32_t, pair<uint32_t, int>> seenTo = {{toId, {toId, 0}}};
+    vector<uint32_t> frontierFrom = {fromId};
+    vector<uint32_t> frontierTo = {toId};
+    int depthFrom = 0;
+    int depthTo = 0;
+    vector<uint32_t> neighbors;
+
+    while (!frontierFrom.empty() && !frontierTo.empty() && depthFrom + depthTo < maxSteps)
+    {
+        // Expand the cheaper side
+        bool forward = frontierFrom.size() <= frontierTo.size();
+        vector<uint32_t> &frontier = forward ? frontierFrom : frontierTo;
+        auto &mine = forward ? seenFrom : seenTo;
+        auto &other = forward ? seenTo : seenFrom;
+        int depth = (forward ? depthFrom : depthTo) + 1;
+
+        // Finish the whole layer, keeping the best meeting word
+        vector<uint32_t> next;
+        uint32_t meet = noWordId;
+        int best = maxSteps + 1;
+        for (uint32_t word : frontier)
+        {
+            ladderNeighbors(word, neighbors);
+            for (uint32_t neighbor : neighbors)
+            {
+                if (mine.count(neighbor))
+                {
+                    continue;
+                }
+                mine[neighbor] = make_pair(word, depth);
+                auto hit = other.find(neighbor);
+                if (hit != other.end() && depth + hit->second.second < best)
+                {
+                    best = depth + hit->second.second;
+                    meet = neighbor;
+                }
+                next.push_back(neighbor);
+            }
+        }
+        (forward ? depthFrom : depthTo) = depth;
+        frontier.swap(next);
+
+        // Stitch the two half-paths together at the meeting word
+        if (meet != noWordId)
+        {
+            for (uint32_t word = meet; word != fromId; word = seenFrom[word].first)
+            {
+                path.push_back(word);
+            }
+            path.push_back(fromId);
+            reverse(path.begin(), path.end());
+            for (uint32_t word = meet; word != toId;)
+            {
+                word = seenTo[word].first;
+                path.push_back(word);
+            }
+            return static_cast<int>(path.size()) - 1;
+        }
+    }
+
+    // No ladder short enough
+    return -1;
+}
+
+// Function to pick start and end words for a ladder puzzle
+// A random walk from a random start proposes the end word, then the
+// bidirectional search finds the real shortest ladder between them
+bool makeLadderPuzzle(uint32_t &startId, uint32_t &endId, vector<uint32_t> &path)
+{
+    // Nothing to do without any ladder buckets
+    size_t wordCount = wordStoreSize(*dictionaryIndex.words);
+    if (dictionaryIndex.ladder.keys.empty() || wordCount == 0)
+    {
+        return false;
+    }
+
+    vector<uint32_t> neighbors;
+    for (int attempt = 0; attempt < ladderAttempts; attempt++)
+    {
+        // Random start that has at least one neighbor
+        startId = static_cast<uint32_t>(static_cast<size_t>(rand()) % wordCount);
+        ladderNeighbors(startId, neighbors);
+        if (neighbors.empty())
+        {
+            continue;
+        }
+
+        // Wander without stepping back on a visited word
+        vector<uint32_t> walk = {startId};
+        for (int step = 0; step < ladderMaxSteps && !neighbors.empty(); step++)
+        {
+            uint32_t next = neighbors[static_cast<size_t>(rand()) % neighbors.size()];
+            if (find(walk.begin(), walk.end(), next) != walk.end())
+            {
+                break;
+            }
+            walk.push_back(next);
+            ladderNeighbors(next, neighbors);
+        }
+        endId = walk.back();
+
+        // Keep the puzzle if its shortest ladder is long enough
+        if (findLadder(startId, endId, ladderMaxSteps, path) >= ladderMinSteps)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Function to play one word ladder puzzle
+void playWordLadder(int &score, int &highestScore)
+{
+    // Generate the puzzle
+    uint32_t startId = 0;
+    uint32_t endId = 0;
+    vector<uint32_t> shortest;
+    if (!makeLadderPuzzle(startId, endId, shortest))
+    {
+        cout << "No word ladder puzzles can be made from the loaded words.\n";
+        return;
+    }
+    string current = wordOf(startId);
+    string target = wordOf(endId);
+    int par = static_cast<int>(shortest.size()) - 1;
+    int movesAllowed = par + ladderExtraMoves;
+
+    // Explain the puzzle
+    cout << "\nWord Ladder: turn \"" << current << "\" into \"" << target << "\" changing one letter at a time.\n";
+    cout << "The shortest ladder takes " << par << " steps. You have " << movesAllowed << " moves.\n";
+
+    // Play until solved or out of moves
+    int moves = 0;
+    int hintsUsed = 0;
+    bool solved = false;
+    string entry;
+    while (moves < movesAllowed && !solved)
+    {
+        cout << "Current word: " << current << ". Next word (or type 'hint' for a hint): ";
+        if (!(cin >> entry))
+        {
+            break;
+        }
+
+        // Hint: next word on a shortest ladder from here
+        if (entry == "hint")
+        {
+            if (hintsUsed >= maxHintsPerWord)
+            {
+                cout << "You have used all available hints for this ladder.\n";
+                continue;
+            }
+            hintsUsed++;
+            vector<uint32_t> route;
+            if (findLadder(findWordId(current), endId, ladderMaxSteps + ladderExtraMoves, route) > 0)
+            {
+                score -= hintCost;
+                cout << "Try \"" << wordOf(route[1]) << "\". Hint cost deducted. Current score: " << score << endl;
+            }
+            else
+            {
+                cout << "No ladder from here; keep trying other words.\n";
+            }
+            continue;
+        }
+        moves++;
+
+        // The entry must be a word exactly one letter away
+        size_t changed = 0;
+        for (size_t i = 0; i < entry.length() && entry.length() == current.length(); i++)
+        {
+            changed += entry[i] != current[i];
+        }
+        if (entry.length() != current.length() || changed != 1 || !isDictionaryWord(entry))
+        {
+            cout << "\"" << entry << "\" is not a word one letter away. Moves left: " << movesAllowed - moves << endl;
+            continue;
+        }
+
+        // Step onto the new word
+        current = entry;
+        solved = current == target;
+    }
+
+    // Score the puzzle
+    if (solved)
+    {
+        int points = par * 2 + (moves == par ? par : 0);
+        cout << "Solved in " << moves << " moves! You earned " << points << " points.\n";
+        updateScore(true, score, highestScore, points);
+    }
+    else
+    {
+        cout << "Out of moves! A shortest ladder was:";
+        for (uint32_t id : shortest)
+        {
+            cout << " " << wordOf(id);
+        }
+        cout << endl;
+        updateScore(false, score, highestScore, 0);
+    }
+
+    // Prompt the user to press Enter to continue
+    cout << "Press \"Enter\" to continue.\n";
+    cin.ignore();
+    cin.get();
+}
+
+// Function to build the trie used by the grid solver
+// Only lowercase words that could fit in the grid are included
+void buildGridTrie(GridTrie &trie, const vector<string> &text)
+{
+    // Distinct usable words in order, each with its first ID
+    vector<pair<string, uint32_t>> entries;
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        const string &word = text[i];
+        if (word.length() >= gridMinWordLength && word.length() <= gridCells &&
+            all_of(word.begin(), word.end(), [](char c)
+                   { return c >= 'a' && c <= 'z'; }))
+        {
+            entries.push_back(make_pair(word, static_cast<uint32_t>(i)));
+        }
+    }
+    sort(entries.begin(), entries.end());
+    entries.erase(unique(entries.begin(), entries.end(), [](const pair<string, uint32_t> &a, const pair<string, uint32_t> &b)
+                         { return a.first == b.first; }),
+                  entries.end());
+
+    // Breadth-first build so every node's children sit together
+    struct NodeRange
+    {
+        size_t lo;
+        size_t hi;
+        size_t depth;
+    };
+    trie = GridTrie();
+    vector<NodeRange> queue = {{0, entries.size(), 0}};
+    for (size_t node = 0; node < queue.size(); node++)
+    {
+        NodeRange range = queue[node];
+
+        // A word equal to the prefix sorts first
+        uint32_t wordId = noWordId;
+        if (range.lo < range.hi && entries[range.lo].first.length() == range.depth)
+        {
+            wordId = entries[range.lo].second;
+            range.lo++;
+        }
+
+        // Queue one child per distinct next letter
+        uint32_t mask = 0;
+        size_t first = queue.size();
+        size_t i = range.lo;
+        while (i < range.hi)
+        {
+            char letter = entries[i].first[range.depth];
+            size_t j = i;
+            while (j < range.hi && entries[j].first[range.depth] == letter)
+            {
+                j++;
+            }
+            mask |= 1u << (letter - 'a');
+            queue.push_back({i, j, range.depth + 1});
+            i = j;
+        }
+        trie.childMasks.push_back(mask);
+        trie.firstChild.push_back(static_cast<uint32_t>(first));
+        trie.wordIds.push_back(wordId);
+    }
+}
+
+// Function to get the cells touching a cell, including diagonals
+uint32_t gridNeighborMask(size_t cell)
+{
+    uint32_t mask = 0;
+    int row = static_cast<int>(cell / gridSize);
+    int col = static_cast<int>(cell % gridSize);
+    for (int dr = -1; dr <= 1; dr++)
+    {
+        for (int dc = -1; dc <= 1; dc++)
+        {
+            int r = row + dr;
+            int c = col + dc;
+            if ((dr != 0 || dc != 0) && r >= 0 && c >= 0 && r < static_cast<int>(gridSize) && c < static_cast<int>(gridSize))
+            {
+                mask |= 1u << (r * static_cast<int>(gridSize) + c);
+            }
+        }
+    }
+    return mask;
+}
+
+// Function to walk the grid from a cell while the path spells a prefix
+// visited is a bitmask of the cells already on the path
+void gridSearchFrom(GridSearch &search, size_t cell, uint32_t node, uint32_t visited)
+{
+    // Neighbor masks are the same for every grid
+    static const array<uint32_t, gridCells> neighbors = []()
+    {
+        array<uint32_t, gridCells> masks;
+        for (size_t i = 0; i < gridCells; i++)
+        {
+            masks[i] = gridNeighborMask(i);
+        }
+        return masks;
+    }();
+    const GridTrie &trie = dictionaryIndex.gridTrie;
+
+    // Record a word the first time this grid reaches it
+    if (trie.wordIds[node] != noWordId && search.stamps[node] != search.stamp)
+    {
+        search.stamps[node] = search.stamp;
+        search.found.push_back(trie.wordIds[node]);
+    }
+
+    // Try every unvisited neighbor whose letter continues a prefix
+    uint32_t options = neighbors[cell] & ~visited;
+    uint32_t childMask = trie.childMasks[node];
+    while (options != 0)
+    {
+        size_t next = static_cast<size_t>(__builtin_ctz(options));
+        options &= options - 1;
+        unsigned letter = static_cast<unsigned>(search.grid[next] - 'a');
+        if ((childMask >> letter & 1) == 0)
+        {
+            continue;
+        }
+        uint32_t child = trie.firstChild[node] + static_cast<uint32_t>(__builtin_popcount(childMask & ((1u << letter) - 1)));
+        gridSearchFrom(search, next, child, visited | (1u << next));
+    }
+}
+
+// Function to find every dictionary word in the search's grid
+void solveGrid(GridSearch &search)
+{
+    // Start a new solve number so stamps from old grids don't count
+    const GridTrie &trie = dictionaryIndex.gridTrie;
+    if (search.stamps.size() != trie.wordIds.size())
+    {
+        search.stamps.assign(trie.wordIds.size(), 0);
+    }
+    search.stamp++;
+    search.found.clear();
+
+    // An empty trie has no words to find
+    if (trie.wordIds.empty())
+    {
+        return;
+    }
+
+    // Start a path from every cell
+    for (size_t cell = 0; cell < gridCells; cell++)
+    {
+        unsigned letter = static_cast<unsigned>(search.grid[cell] - 'a');
+        uint32_t rootMask = trie.childMasks[0];
+        if ((rootMask >> letter & 1) != 0)
+        {
+            uint32_t child = trie.firstChild[0] + static_cast<uint32_t>(__builtin_popcount(rootMask & ((1u << letter) - 1)));
+            gridSearchFrom(search, cell, child, 1u << cell);
+        }
+    }
+}
+
+// Function to fill a grid with letters weighted by English frequency
+void randomGrid(string &grid, mt19937 &rng)
+{
+    // Letter weights in tenths of a percent, a to z
+    static const array<int, 26> weights = {82, 15, 28, 43, 127, 22, 20, 61, 70, 2, 8, 40, 24,
+                                           67, 75, 19, 1, 60, 63, 91, 28, 10, 24, 2, 20, 1};
+    discrete_distribution<int> pick(weights.begin(), weights.end());
+    grid.resize(gridCells);
+    for (char &letter : grid)
+    {
+        letter = static_cast<char>('a' + pick(rng));
+    }
+}
+
+// Function to pick the grid with the most words from many candidates
+// The candidates are split across all cores; each thread keeps its
+// best grid and the best of those wins
+void generateBestGrid(string &bestGrid, vector<uint32_t> &bestWords)
+{
+    // One worker per core
+    size_t threadCount = max(1u, thread::hardware_concurrency());
+    vector<GridSearch> best(threadCount);
+    vector<thread> workers;
+    unsigned seed = static_cast<unsigned>(rand());
+    for (size_t t = 0; t < threadCount; t++)
+    {
+        workers.emplace_back([&, t]()
+                             {
+            GridSearch search;
+            mt19937 rng(seed + static_cast<unsigned>(t));
+            for (size_t g = t; g < static_cast<size_t>(gridCandidates); g += threadCount)
+            {
+                randomGrid(search.grid, rng);
+                solveGrid(search);
+                if (best[t].grid.empty() || search.found.size() > best[t].found.size())
+                {
+                    best[t].grid = search.grid;
+                    best[t].found = search.found;
+                }
+            } });
+    }
+    for (thread &worker : workers)
+    {
+        worker.join();
+    }
+
+    // Keep the richest grid overall
+    size_t winner = 0;
+    for (size_t t = 1; t < threadCount; t++)
+    {
+        if (best[t].found.size() > best[winner].found.size())
+        {
+            winner = t;
+        }
+    }
+    bestGrid = best[winner].grid;
+    bestWords = best[winner].found;
+}
+
+// Function to score a word found in the grid
+int gridWordPoints(size_t length)
+{
+    // Longer words are worth much more
+    if (length <= 4)
+    {
+        return 1;
+    }
+    if (length <= 6)
+    {
+        return static_cast<int>(length) - 3;
+    }
+    if (length == 7)
+    {
+        return 5;
+    }
+    return 11;
+}
+
+// Function to play one letter grid round
+void playLetterGrid(int &score, int &highestScore)
+{
+    // Generate the grid and its full answer list
+    string grid;
+    vector<uint32_t> answerIds;
+    generateBestGrid(grid, answerIds);
+    if (answerIds.empty())
+    {
+        cout << "No letter grid with words can be made from the loaded words.\n";
+        return;
+    }
+
+    // Answers sorted for lookup
+    vector<string> answers;
+    for (uint32_t id : answerIds)
+    {
+        answers.push_back(wordOf(id));
+    }
+    sort(answers.begin(), answers.end());
+
+    // Show the grid
+    cout << "\nLetter Grid: find words by joining touching letters (diagonals count).\n";
+    cout << "Words need at least " << gridMinWordLength << " letters and each cell is used once per word.\n";
+    for (size_t row = 0; row < gridSize; row++)
+    {
+        cout << "  ";
+        for (size_t col = 0; col < gridSize; col++)
+        {
+            cout << static_cast<char>(toupper(grid[row * gridSize + col])) << ' ';
+        }
+        cout << endl;
+    }
+    cout << "This grid hides " << answers.size() << " words.\n";
+
+    // Collect the player's words
+    vector<string> claimed;
+    int points = 0;
+    string entry;
+    while (true)
+    {
+        cout << "Enter a word (or type 'done' to finish): ";
+        if (!(cin >> entry) || entry == "done")
+        {
+            break;
+        }
+        transform(entry.begin(), entry.end(), entry.begin(), [](unsigned char c)
+                  { return static_cast<char>(tolower(c)); });
+
+        // Check the word against the solver's answers
+        if (find(claimed.begin(), claimed.end(), entry) != claimed.end())
+        {
+            cout << "You already found \"" << entry << "\".\n";
+        }
+        else if (binary_search(answers.begin(), answers.end(), entry))
+        {
+            claimed.push_back(entry);
+            int earned = gridWordPoints(entry.length());
+            points += earned;
+            cout << "Found! +" << earned << " (" << claimed.size() << "/" << answers.size() << ")\n";
+        }
+        else
+        {
+            cout << "\"" << entry << "\" is not in the grid.\n";
+        }
+    }
+
+    // Show how the player did and the longest words missed
+    cout << "You found " << claimed.size() << " of " << answers.size() << " words for " << points << " points.\n";
+    stable_sort(answers.begin(), answers.end(), [](const string &a, const string &b)
+                { return a.length() > b.length(); });
+    cout << "Longest words:";
+    for (size_t i = 0; i < answers.size() && i < 10; i++)
+    {
+        cout << " " << answers[i];
+    }
+    cout << endl;
+    if (points > 0)
+    {
+        updateScore(true, score, highestScore, points);
+    }
+
+    // Prompt the user to press Enter to continue
+    cout << "Press \"Enter\" to continue.\n";
+    cin.ignore();
+    cin.get();
+}
+
+// Function to get the set of letters in a word as a 26-bit mask
+// Any character outside a-z sets bit 31 so the word never qualifies
+uint32_t letterMaskOf(const string &word)
+{
+    uint32_t mask = 0;
+    for (char c : word)
+    {
+        unsigned letter = static_cast<unsigned>(c - 'a');
+        mask |= letter < 26 ? 1u << letter : 1u << 31;
+    }
+    return mask;
+}
+
+// Function to group spelling bee words by letter set
+void buildBeeIndex(BeeIndex &bee, const vector<uint32_t> &letterMasks, const vector<string> &text)
+{
+    // Usable words: long enough, letters only, at most seven distinct
+    vector<tuple<uint32_t, uint64_t, uint32_t>> entries;
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        uint32_t mask = letterMasks[i];
+        if (text[i].length() >= beeMinWordLength && (mask >> 31) == 0 && __builtin_popcount(mask) <= beeLetters)
+        {
+            entries.push_back(make_tuple(mask, hashWord(text[i]), static_cast<uint32_t>(i)));
+        }
+    }
+    sort(entries.begin(), entries.end());
+
+    // Pack into sorted groups, keeping one ID per distinct word
+    bee = BeeIndex();
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        uint32_t mask = get<0>(entries[i]);
+        if (i > 0 && mask == get<0>(entries[i - 1]) && get<1>(entries[i]) == get<1>(entries[i - 1]))
+        {
+            continue;
+        }
+        if (bee.masks.empty() || bee.masks.back() != mask)
+        {
+            bee.masks.push_back(mask);
+            bee.starts.push_back(static_cast<uint32_t>(bee.wordIds.size()));
+        }
+        bee.wordIds.push_back(get<2>(entries[i]));
+    }
+    bee.starts.push_back(static_cast<uint32_t>(bee.wordIds.size()));
+}
+
+// Function to find the group for a letter set
+// Returns the number of groups if there is none
+size_t beeGroup(uint32_t mask)
+{
+    const BeeIndex &bee = dictionaryIndex.bee;
+    auto found = lower_bound(bee.masks.begin(), bee.masks.end(), mask);
+    if (found == bee.masks.end() || *found != mask)
+    {
+        return bee.masks.size();
+    }
+    return static_cast<size_t>(found - bee.masks.begin());
+}
+
+// Function to list every answer to a spelling bee
+// Answers use only the puzzle letters and include the center, so they
+// are exactly the groups for the 64 subsets of the other six letters
+// with the center added
+void findBeeAnswers(const BeePuzzle &puzzle, vector<uint32_t> &wordIds)
+{
+    wordIds.clear();
+    const BeeIndex &bee = dictionaryIndex.bee;
+    uint32_t others = puzzle.letters & ~puzzle.center;
+
+    // Walk every subset of the other letters, including the empty one
+    uint32_t subset = others;
+    while (true)
+    {
+        size_t group = beeGroup(subset | puzzle.center);
+        if (group < bee.masks.size())
+        {
+            wordIds.insert(wordIds.end(), bee.wordIds.begin() + bee.starts[group], bee.wordIds.begin() + bee.starts[group + 1]);
+        }
+        if (subset == 0)
+        {
+            break;
+        }
+        subset = (subset - 1) & others;
+    }
+}
+
+// Function to pick a spelling bee with a pangram near the target size
+// Every seven-letter group holds a pangram, so each of them with each
+// choice of center is a candidate. The groups are split across all
+// cores; each candidate's answers are counted from the 128 subsets
+bool generateBeePuzzle(BeePuzzle &puzzle)
+{
+    // Letter sets that some word uses completely
+    const BeeIndex &bee = dictionaryIndex.bee;
+    vector<uint32_t> pangramMasks;
+    for (uint32_t mask : bee.masks)
+    {
+        if (__builtin_popcount(mask) == beeLetters)
+        {
+            pangramMasks.push_back(mask);
+        }
+    }
+    if (pangramMasks.empty())
+    {
+        return false;
+    }
+
+    // Each worker keeps candidates near the target and its closest miss
+    size_t threadCount = max(1u, thread::hardware_concurrency());
+    vector<vector<BeePuzzle>> nearTarget(threadCount);
+    vector<BeePuzzle> closest(threadCount);
+    vector<thread> workers;
+    for (size_t t = 0; t < threadCount; t++)
+    {
+        workers.emplace_back([&, t]()
+                             {
+            for (size_t m = t; m < pangramMasks.size(); m += threadCount)
+            {
+                // Word count of every subset of the seven letters
+                uint32_t letters = pangramMasks[m];
+                array<int, 26> perCenter = {};
+                uint32_t subset = letters;
+                while (subset != 0)
+                {
+                    size_t group = beeGroup(subset);
+                    if (group < bee.masks.size())
+                    {
+                        int count = static_cast<int>(bee.starts[group + 1] - bee.starts[group]);
+                        for (uint32_t bits = subset; bits != 0; bits &= bits - 1)
+                        {
+                            perCenter[__builtin_ctz(bits)] += count;
+                        }
+                    }
+                    subset = (subset - 1) & letters;
+                }
+
+                // Every letter can be the center
+                for (uint32_t bits = letters; bits != 0; bits &= bits - 1)
+                {
+                    BeePuzzle candidate;
+                    candidate.letters = letters;
+                    candidate.center = bits & (~bits + 1);
+                    candidate.answerCount = perCenter[__builtin_ctz(bits)];
+                    int distance = abs(candidate.answerCount - beeTargetAnswers);
+                    if (distance <= beeAnswerTolerance)
+                    {
+                        nearTarget[t].push_back(candidate);
+                    }
+                    if (closest[t].letters == 0 || distance < abs(closest[t].answerCount - beeTargetAnswers))
+                    {
+                        closest[t] = candidate;
+                    }
+                }
+            } });
+    }
+    for (thread &worker : workers)
+    {
+        worker.join();
+    }
+
+    // Pick a random candidate near the target, or the closest one
+    vector<BeePuzzle> pool;
+    for (const auto &candidates : nearTarget)
+    {
+        pool.insert(pool.end(), candidates.begin(), candidates.end());
+    }
+    if (!pool.empty())
+    {
+        puzzle = pool[static_cast<size_t>(rand()) % pool.size()];
+        return true;
+    }
+    puzzle = closest[0];
+    for (const BeePuzzle &candidate : closest)
+    {
+        if (candidate.letters != 0 && abs(candidate.answerCount - beeTargetAnswers) < abs(puzzle.answerCount - beeTargetAnswers))
+        {
+            puzzle = candidate;
+        }
+    }
+    return true;
+}
+
+// Function to play one spelling bee
+void playSpellingBee(int &score, int &highestScore)
+{
+    // Generate the puzzle and its answers
+    BeePuzzle puzzle;
+    if (!generateBeePuzzle(puzzle))
+    {
+        cout << "No spelling bee can be made from the loaded words.\n";
+        return;
+    }
+    vector<uint32_t> answerIds;
+    findBeeAnswers(puzzle, answerIds);
+    vector<string> answers;
+    for (uint32_t id : answerIds)
+    {
+        answers.push_back(wordOf(id));
+    }
+    sort(answers.begin(), answers.end());
+
+    // Show the letters, center in brackets
+    cout << "\nSpelling Bee: make words of " << beeMinWordLength << "+ letters from these letters.\n";
+    cout << "Every word must use the center letter; letters may repeat.\n  ";
+    for (int letter = 0; letter < 26; letter++)
+    {
+        if (puzzle.center == (1u << letter))
+        {
+            cout << "[" << static_cast<char>('A' + letter) << "] ";
+        }
+        else if (puzzle.letters & (1u << letter))
+        {
+            cout << static_cast<char>('A' + letter) << " ";
+        }
+    }
+    cout << "\nThere are " << answers.size() << " words to find, including at least one that uses every letter.\n";
+
+    // Collect the player's words
+    vector<string> claimed;
+    int points = 0;
+    string entry;
+    while (true)
+    {
+        cout << "Enter a word (or type 'done' to finish): ";
+        if (!(cin >> entry) || entry == "done")
+        {
+            break;
+        }
+        transform(entry.begin(), entry.end(), entry.begin(), [](unsigned char c)
+                  { return static_cast<char>(tolower(c)); });
+
+        if (find(claimed.begin(), claimed.end(), entry) != claimed.end())
+        {
+            cout << "You already found \"" << entry << "\".\n";
+        }
+        else if (binary_search(answers.begin(), answers.end(), entry))
+        {
+            // Four-letter words are worth 1, longer ones their length
+            claimed.push_back(entry);
+            int earned = entry.length() == beeMinWordLength ? 1 : static_cast<int>(entry.length());
+            if (letterMaskOf(entry) == puzzle.letters)
+            {
+                earned += beePangramBonus;
+                cout << "Pangram! ";
+            }
+            points += earned;
+            cout << "+" << earned << " (" << claimed.size() << "/" << answers.size() << ")\n";
+        }
+        else
+        {
+            cout << "\"" << entry << "\" is not an answer.\n";
+        }
+    }
+
+    // Show how the player did and the pangrams
+    cout << "You found " << claimed.size() << " of " << answers.size() << " words for " << points << " points.\n";
+    cout << "Pangrams:";
+    for (const string &answer : answers)
+    {
+        if (letterMaskOf(answer) == puzzle.letters)
+        {
+            cout << " " << answer;
+        }
+    }
+    cout << endl;
+    if (points > 0)
+    {
+        updateScore(true, score, highestScore, points);
+    }
+
+    // Prompt the user to press Enter to continue
+    cout << "Press \"Enter\" to continue.\n";
+    cin.ignore();
+    cin.get();
+}
+
+// Function to map a whole file read-only
+// Returns false if the file can't be opened
+bool mapFile(MappedFile &file, const string &filename)
+{
+    // Drop anything mapped before
+    unmapFile(file);
+
+#ifdef UNSCRAMBLE_POSIX_MMAP
+    // Map the file; pages load lazily as they are touched
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0)
+    {
+        close(fd);
+        return false;
+    }
+    void *address = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED)
+    {
+        return false;
+    }
+    file.data = static_cast<const uint8_t *>(address);
+    file.size = static_cast<size_t>(info.st_size);
+    file.mapped = true;
+    return true;
+#else
+    // No mmap: read the whole file instead
+    ifstream in(filename, ios::binary);
+    if (!in)
+    {
+        return false;
+    }
+    file.buffer.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    if (file.buffer.empty())
+    {
+        return false;
+    }
+    file.data = file.buffer.data();
+    file.size = file.buffer.size();
+    return true;
+#endif
+}
+
+// Function to release a mapped file
+void unmapFile(MappedFile &file)
+{
+#ifdef UNSCRAMBLE_POSIX_MMAP
+    if (file.mapped)
+    {
+        munmap(const_cast<uint8_t *>(file.data), file.size);
+    }
+#endif
+    file.data = nullptr;
+    file.size = 0;
+    file.mapped = false;
+    file.buffer.clear();
+}
+
+// Function to pack a word of up to 8 letters into one byte per letter
+// Unused bytes stay 0, which never matches a letter
+uint64_t packLetters(const string &word)
+{
+    uint64_t packed = 0;
+    for (size_t i = 0; i < word.length() && i < 8; i++)
+    {
+        packed |= static_cast<uint64_t>(static_cast<unsigned char>(word[i])) << (8 * i);
+    }
+    return packed;
+}
+
+// Function to score a guess against an answer, Wordle style
+// Greens first; then each other guess letter is yellow while the
+// answer still has an unmatched copy of it
+uint16_t wordleFeedback(uint64_t guess, uint64_t answer, size_t length)
+{
+    // Powers of three, one per position
+    static const uint16_t powers[8] = {1, 3, 9, 27, 81, 243, 729, 2187};
+
+    // Greens, counting the answer letters they leave unmatched
+    // (a-z masked to 5 bits are 1-26, so 32 buckets cover them)
+    uint8_t left[32] = {};
+    uint16_t pattern = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        unsigned g = (guess >> (8 * i)) & 0xFF;
+        unsigned a = (answer >> (8 * i)) & 0xFF;
+        if (g == a)
+        {
+            pattern += 2 * powers[i];
+        }
+        else
+        {
+            left[a & 31]++;
+        }
+    }
+
+    // Yellows, left to right
+    for (size_t i = 0; i < length; i++)
+    {
+        unsigned g = (guess >> (8 * i)) & 0xFF;
+        unsigned a = (answer >> (8 * i)) & 0xFF;
+        if (g != a && left[g & 31] > 0)
+        {
+            left[g & 31]--;
+            pattern += powers[i];
+        }
+    }
+    return pattern;
+}
+
+#ifdef UNSCRAMBLE_X86_SIMD
+// AVX2 kernel: one guess against four answers per register
+// Each 64-bit lane holds one packed answer. Greens are a byte compare;
+// a non-green letter is yellow when the answer has more unmatched
+// copies of it than the guess used in earlier non-green positions,
+// and both counts come from a byte compare summed with one SAD
+__attribute__((target("avx2"))) void wordleRowAvx2(uint64_t guess, const vector<uint64_t> &packed, size_t length, uint16_t *row)
+{
+    static const long long powers[8] = {1, 3, 9, 27, 81, 243, 729, 2187};
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i oneBytes = _mm256_set1_epi8(1);
+    const __m256i oneLanes = _mm256_set1_epi64x(1);
+    __m256i guesses = _mm256_set1_epi64x(static_cast<long long>(guess));
+    __m256i lanes = _mm256_set1_epi64x(static_cast<long long>(length >= 8 ? ~0ULL : (1ULL << (8 * length)) - 1));
+
+    size_t count = packed.size() / 4 * 4;
+    for (size_t a = 0; a < count; a += 4)
+    {
+        // Greens as 0xFF bytes; matched letters are blanked out
+        __m256i answers = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(packed.data() + a));
+        __m256i green = _mm256_and_si256(_mm256_cmpeq_epi8(guesses, answers), lanes);
+        __m256i answerLeft = _mm256_or_si256(answers, green);
+        __m256i guessLeft = _mm256_or_si256(guesses, green);
+
+        __m256i pattern = zero;
+        for (size_t i = 0; i < length; i++)
+        {
+            // Count this letter in what is left of each answer and in
+            // the guess before position i
+            __m256i letter = _mm256_set1_epi8(static_cast<char>((guess >> (8 * i)) & 0xFF));
+            __m256i before = _mm256_set1_epi64x(static_cast<long long>((1ULL << (8 * i)) - 1));
+            __m256i available = _mm256_sad_epu8(_mm256_and_si256(_mm256_cmpeq_epi8(answerLeft, letter), oneBytes), zero);
+            __m256i used = _mm256_sad_epu8(_mm256_and_si256(_mm256_and_si256(_mm256_cmpeq_epi8(guessLeft, letter), before), oneBytes), zero);
+
+            // Digit: 2 for green, 1 for yellow, 0 for gray
+            __m256i isGreen = _mm256_and_si256(_mm256_srli_epi64(green, static_cast<int>(8 * i)), oneLanes);
+            __m256i isYellow = _mm256_andnot_si256(isGreen, _mm256_and_si256(_mm256_cmpgt_epi64(available, used), oneLanes));
+            __m256i digit = _mm256_add_epi64(_mm256_add_epi64(isGreen, isGreen), isYellow);
+            pattern = _mm256_add_epi64(pattern, _mm256_mul_epu32(digit, _mm256_set1_epi64x(powers[i])));
+        }
+
+        // Store the four patterns
+        alignas(32) uint64_t out[4];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(out), pattern);
+        for (size_t k = 0; k < 4; k++)
+        {
+            row[a + k] = static_cast<uint16_t>(out[k]);
+        }
+    }
+
+    // Leftover answers take the scalar path
+    for (size_t a = count; a < packed.size(); a++)
+    {
+        row[a] = wordleFeedback(guess, packed[a], length);
+    }
+}
+#endif
+
+// Function to fill the pattern matrix for a pool of packed words
+// Rows are split across all cores, four answers at a time with AVX2
+void computeWordlePatterns(const vector<uint64_t> &packed, size_t length, uint16_t *patterns)
+{
+    size_t count = packed.size();
+    size_t threadCount = max(1u, thread::hardware_concurrency());
+    vector<thread> workers;
+    for (size_t t = 0; t < threadCount; t++)
+    {
+        workers.emplace_back([&, t]()
+                             {
+            for (size_t g = t; g < count; g += threadCount)
+            {
+                uint16_t *row = patterns + g * count;
+#ifdef UNSCRAMBLE_X86_SIMD
+                // Vector kernel when the CPU has it
+                if (cpuHasAvx2())
+                {
+                    wordleRowAvx2(packed[g], packed, length, row);
+                    continue;
+                }
+#endif
+
+                // Scalar fallback
+                for (size_t a = 0; a < count; a++)
+                {
+                    row[a] = wordleFeedback(packed[g], packed[a], length);
+                }
+            } });
+    }
+    for (thread &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+// Function to get the pattern table for a word length
+// Built on first use: the matrix is mapped from its cache file when
+// that matches the current words, otherwise computed and saved
+WordleTable &wordleTable(size_t length)
+{
+    WordleTable &table = dictionaryIndex.wordle[length - mediumMinLength];
+    if (table.length == length)
+    {
+        return table;
+    }
+    table.length = length;
+
+    // Pool: distinct lowercase words of this length. When there are too
+    // many, the words seen most in the corpus are kept, then the rest by
+    // a fixed hash, which samples the whole length rather than the start
+    // of an alphabetical list and keeps the pool, and its cache, stable
+    const WordStore &words = *dictionaryIndex.words;
+    vector<pair<uint64_t, uint32_t>> candidates;
+    for (size_t i = 0; i < words.lengths.size(); i++)
+    {
+        if (words.lengths[i] != length)
+        {
+            continue;
+        }
+        string word = wordOf(static_cast<uint32_t>(i));
+        if (all_of(word.begin(), word.end(), [](char c)
+                   { return c >= 'a' && c <= 'z'; }))
+        {
+            candidates.push_back(make_pair(hashWord(word), static_cast<uint32_t>(i)));
+        }
+    }
+    sort(candidates.begin(), candidates.end());
+    vector<tuple<uint32_t, uint64_t, uint32_t>> ranked;
+    for (size_t i = 0; i < candidates.size(); i++)
+    {
+        if (i == 0 || candidates[i].first != candidates[i - 1].first)
+        {
+            const FrequencyEntry *entry = frequencyEntry(candidates[i].second);
+            uint32_t unseen = numeric_limits<uint32_t>::max() - (entry != nullptr ? entry->count : 0);
+            ranked.push_back(make_tuple(unseen, mixHash(candidates[i].first, wordleSampleSeed), candidates[i].second));
+        }
+    }
+    if (ranked.size() > wordleMaxWords)
+    {
+        nth_element(ranked.begin(), ranked.begin() + wordleMaxWords, ranked.end());
+        ranked.resize(wordleMaxWords);
+    }
+    for (const tuple<uint32_t, uint64_t, uint32_t> &word : ranked)
+    {
+        table.wordIds.push_back(get<2>(word));
+    }
+    sort(table.wordIds.begin(), table.wordIds.end());
+
+    // Packed letters and a fingerprint of the pool
+    size_t count = table.wordIds.size();
+    uint64_t fingerprint = length;
+    for (uint32_t id : table.wordIds)
+    {
+        string word = wordOf(id);
+        table.packed.push_back(packLetters(word));
+        fingerprint = mixHash(fingerprint ^ hashWord(word), count);
+    }
+
+    // Use the cache file if it was made from the same pool
+    string filename = "wordle" + to_string(length) + ".cache";
+    size_t matrixBytes = count * count * sizeof(uint16_t);
+    if (mapFile(table.cache, filename) && table.cache.size == sizeof(WordleCacheHeader) + matrixBytes)
+    {
+        WordleCacheHeader header;
+        memcpy(&header, table.cache.data, sizeof(header));
+        if (header.magic == wordleCacheMagic && header.length == length && header.count == count && header.fingerprint == fingerprint)
+        {
+            table.patterns = reinterpret_cast<const uint16_t *>(table.cache.data + sizeof(header));
+            return table;
+        }
+    }
+    unmapFile(table.cache);
+
+    // Compute the matrix and save it for next time, under a temporary
+    // name renamed into place, so a reader never maps half a file. A
+    // failed write leaves no cache rather than a stale one
+    table.computed.resize(count * count);
+    computeWordlePatterns(table.packed, length, table.computed.data());
+    table.patterns = table.computed.data();
+    WordleCacheHeader header = {wordleCacheMagic, static_cast<uint32_t>(length), static_cast<uint32_t>(count), 0, fingerprint};
+    string temporary = filename + ".tmp";
+    ofstream out(temporary, ios::binary);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(table.computed.data()), static_cast<streamsize>(matrixBytes));
+    out.close();
+    if (!out || rename(temporary.c_str(), filename.c_str()) != 0)
+    {
+        remove(temporary.c_str());
+        remove(filename.c_str());
+    }
+    return table;
+}
+
+// Function to find the guess that tells the most about the answer
+// remaining holds pool indexes of the answers still possible. Each
+// guess splits them by pattern; the guess whose split has the highest
+// entropy wins, preferring one that could itself be the answer
+size_t bestWordleGuess(const WordleTable &table, const vector<uint32_t> &remaining)
+{
+    // One or two answers left: just guess one
+    size_t count = table.wordIds.size();
+    if (remaining.size() <= 2)
+    {
+        return remaining[0];
+    }
+    vector<char> possible(count, 0);
+    for (uint32_t a : remaining)
+    {
+        possible[a] = 1;
+    }
+
+    // Each worker scores a stripe of guesses
+    size_t patternCount = 1;
+    for (size_t i = 0; i < table.length; i++)
+    {
+        patternCount *= 3;
+    }
+    double total = static_cast<double>(remaining.size());
+    size_t threadCount = max(1u, thread::hardware_concurrency());
+    vector<pair<double, size_t>> best(threadCount, make_pair(-1.0, size_t(0)));
+    vector<thread> workers;
+    for (size_t t = 0; t < threadCount; t++)
+    {
+        workers.emplace_back([&, t]()
+                             {
+            vector<uint32_t> buckets(patternCount, 0);
+            for (size_t g = t; g < count; g += threadCount)
+            {
+                // Answers per pattern for this guess
+                const uint16_t *row = table.patterns + g * count;
+                for (uint32_t a : remaining)
+                {
+                    buckets[row[a]]++;
+                }
+
+                // Entropy of the split, clearing the buckets as we go
+                double sum = 0.0;
+                for (uint32_t a : remaining)
+                {
+                    uint32_t size = buckets[row[a]];
+                    if (size != 0)
+                    {
+                        sum += size * log2(static_cast<double>(size));
+                        buckets[row[a]] = 0;
+                    }
+                }
+                double entropy = log2(total) - sum / total + (possible[g] ? 1e-9 : 0.0);
+                if (entropy > best[t].first)
+                {
+                    best[t] = make_pair(entropy, g);
+                }
+            } });
+    }
+    for (thread &worker : workers)
+    {
+        worker.join();
+    }
+
+    // Keep the best guess overall
+    pair<double, size_t> winner = best[0];
+    for (const auto &candidate : best)
+    {
+        if (candidate.first > winner.first)
+        {
+            winner = candidate;
+        }
+    }
+    return winner.second;
+}
+
+// Function to play one wordle puzzle
+void playWordle(int &score, int &highestScore)
+{
+    // Pick a length from the medium range that has enough words
+    const vector<uint8_t> &wordLengths = dictionaryIndex.words->lengths;
+    vector<size_t> lengths;
+    for (size_t length = mediumMinLength; length <= mediumMaxLength; length++)
+    {
+        if (count(wordLengths.begin(), wordLengths.end(), length) >= 2)
+        {
+            lengths.push_back(length);
+        }
+    }
+    const WordleTable *chosen = lengths.empty() ? nullptr : &wordleTable(lengths[static_cast<size_t>(rand()) % lengths.size()]);
+    if (chosen == nullptr || chosen->wordIds.size() < 2)
+    {
+        cout << "No wordle puzzles can be made from the loaded words.\n";
+        return;
+    }
+    const WordleTable &table = *chosen;
+    size_t count = table.wordIds.size();
+    size_t length = table.length;
+    uint32_t answer = static_cast<uint32_t>(static_cast<size_t>(rand()) % count);
+    uint16_t solvedPattern = static_cast<uint16_t>(pow(3, length) - 1);
+
+    // Every pool word could be the answer at the start
+    vector<uint32_t> remaining(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        remaining[i] = static_cast<uint32_t>(i);
+    }
+
+    // Explain the puzzle
+    cout << "\nWordle: guess the " << length << "-letter word in " << wordleMaxGuesses << " tries.\n";
+    cout << "Green: right letter, right spot. Yellow: in the word, wrong spot. Gray: not in the word.\n";
+
+    // Play until solved or out of guesses
+    int guesses = 0;
+    int hintsUsed = 0;
+    vector<size_t> hinted;
+    bool solved = false;
+    string entry;
+    while (guesses < wordleMaxGuesses && !solved)
+    {
+        cout << "Guess " << guesses + 1 << "/" << wordleMaxGuesses << " (or type 'hint' for a hint): ";
+        if (!(cin >> entry))
+        {
+            break;
+        }
+        transform(entry.begin(), entry.end(), entry.begin(), [](unsigned char c)
+                  { return static_cast<char>(tolower(c)); });
+
+        // Hint: the guess that narrows the answers down most. Until a
+        // guess changes the answers it stays the same, so a suggestion
+        // already given is repeated free
+        if (entry == "hint")
+        {
+            size_t hint = bestWordleGuess(table, remaining);
+            if (find(hinted.begin(), hinted.end(), hint) != hinted.end())
+            {
+                cout << "Still \"" << wordOf(table.wordIds[hint]) << "\" (" << remaining.size()
+                     << " words are still possible). No charge for a repeated hint.\n";
+                continue;
+            }
+            if (hintsUsed >= maxHintsPerWord)
+            {
+                cout << "You have used all available hints for this word.\n";
+                continue;
+            }
+            hintsUsed++;
+            hinted.push_back(hint);
+            score -= hintCost;
+            cout << "Try \"" << wordOf(table.wordIds[hint]) << "\" (" << remaining.size()
+                 << " words are still possible). Hint cost deducted. Current score: " << score << endl;
+            continue;
+        }
+
+        // The guess must be a dictionary word of the right length
+        if (entry.length() != length || !isDictionaryWord(entry))
+        {
+            cout << "\"" << entry << "\" is not a " << length << "-letter word.\n";
+            continue;
+        }
+        guesses++;
+
+        // Pool guesses read their row; others are scored directly
+        uint32_t id = findWordId(entry);
+        auto found = lower_bound(table.wordIds.begin(), table.wordIds.end(), id);
+        bool inPool = found != table.wordIds.end() && *found == id;
+        const uint16_t *row = inPool ? table.patterns + static_cast<size_t>(found - table.wordIds.begin()) * count : nullptr;
+        uint64_t packed = packLetters(entry);
+        auto patternFor = [&](uint32_t a)
+        {
+            return row ? row[a] : wordleFeedback(packed, table.packed[a], length);
+        };
+        uint16_t pattern = patternFor(answer);
+
+        // Show the colored letters
+        uint16_t digits = pattern;
+        cout << "  ";
+        for (size_t i = 0; i < length; i++)
+        {
+            const char *color = digits % 3 == 2 ? "\033[30;42m" : digits % 3 == 1 ? "\033[30;43m"
+                                                                                 : "\033[37;100m";
+            cout << color << ' ' << static_cast<char>(toupper(entry[i])) << " \033[0m";
+            digits /= 3;
+        }
+        cout << endl;
+
+        // Keep the answers that would give the same colors
+        vector<uint32_t> next;
+        for (uint32_t a : remaining)
+        {
+            if (patternFor(a) == pattern)
+            {
+                next.push_back(a);
+            }
+        }
+        remaining.swap(next);
+        solved = pattern == solvedPattern;
+    }
+
+    // Score the puzzle
+    if (solved)
+    {
+        int points = (wordleMaxGuesses - guesses + 1) * 2;
+        cout << "Solved in " << guesses << " guesses! You earned " << points << " points.\n";
+        updateScore(true, score, highestScore, points);
+    }
+    else
+    {
+        cout << "Out of guesses! The word was \"" << wordOf(table.wordIds[answer]) << "\".\n";
+        updateScore(false, score, highestScore, 0);
+    }
+
+    // Prompt the user to press Enter to continue
+    cout << "Press \"Enter\" to continue.\n";
+    cin.ignore();
+    cin.get();
+}
+
+// Function to group hangman words by length into flat buckets
+void buildHangmanIndex(array<HangmanBucket, hangmanMaxLength + 1> &buckets, const vector<uint32_t> &letterMasks, const vector<string> &text)
+{
+    // Distinct lowercase words of a playable length, first by ID
+    vector<pair<uint64_t, uint32_t>> entries;
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        size_t length = text[i].length();
+        if (length >= hangmanMinLength && length <= hangmanMaxLength && (letterMasks[i] >> 31) == 0)
+        {
+            entries.push_back(make_pair(hashWord(text[i]), static_cast<uint32_t>(i)));
+        }
+    }
+    sort(entries.begin(), entries.end());
+
+    // Append each to its length's bucket
+    for (HangmanBucket &bucket : buckets)
+    {
+        bucket = HangmanBucket();
+    }
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        if (i > 0 && entries[i].first == entries[i - 1].first)
+        {
+            continue;
+        }
+        uint32_t id = entries[i].second;
+        HangmanBucket &bucket = buckets[text[id].length()];
+        bucket.wordIds.push_back(id);
+        bucket.letters.push_back(packLetters(text[id]));
+        bucket.letters.push_back(packLetters(text[id].length() > 8 ? text[id].substr(8) : string()));
+    }
+}
+
+// Function to get the high bit of every zero byte in a 64-bit word
+// Exact, with no false hits from borrows between bytes
+uint64_t zeroByteFlags(uint64_t x)
+{
+    const uint64_t low7 = 0x7F7F7F7F7F7F7F7FULL;
+    return ~(((x & low7) + low7) | x | low7);
+}
+
+// Function to split the candidates by where a letter appears and keep
+// the largest family, so the guess helps the player as little as it can
+// candidates holds bucket indexes and is compacted in place. Returns
+// the positions of the letter in the kept family (0 if it's absent)
+uint32_t partitionHangman(const HangmanBucket &bucket, size_t length, vector<uint32_t> &candidates, char letter)
+{
+    // Family of each candidate: a bitmask of the positions holding the
+    // letter. Eight bytes are compared at once and a multiply gathers
+    // the eight match flags into the low bits, with no branches
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t gather = 0x0102040810204080ULL;
+    uint64_t broadcast = ones * static_cast<unsigned char>(letter);
+    vector<uint32_t> families(candidates.size());
+    vector<uint32_t> sizes(size_t(1) << length, 0);
+    for (size_t k = 0; k < candidates.size(); k++)
+    {
+        const uint64_t *word = bucket.letters.data() + 2 * static_cast<size_t>(candidates[k]);
+        uint64_t low = zeroByteFlags(word[0] ^ broadcast) >> 7;
+        uint64_t high = zeroByteFlags(word[1] ^ broadcast) >> 7;
+        uint32_t family = static_cast<uint32_t>((low * gather) >> 56 | ((high * gather) >> 56) << 8);
+        families[k] = family;
+        sizes[family]++;
+    }
+
+    // Largest family; ties go to the one revealing fewer letters
+    uint32_t kept = 0;
+    for (uint32_t family = 1; family < sizes.size(); family++)
+    {
+        if (sizes[family] > sizes[kept] ||
+            (sizes[family] == sizes[kept] && __builtin_popcount(family) < __builtin_popcount(kept)))
+        {
+            kept = family;
+        }
+    }
+
+    // Keep only that family's candidates, again without branches
+    size_t size = 0;
+    for (size_t k = 0; k < candidates.size(); k++)
+    {
+        candidates[size] = candidates[k];
+        size += families[k] == kept;
+    }
+    candidates.resize(size);
+    return kept;
+}
+
+// Function to play one evil hangman round
+// The word is never chosen: every guess keeps the most words possible
+void playEvilHangman(int &score, int &highestScore)
+{
+    // Pick a length with enough words
+    vector<size_t> lengths;
+    for (size_t length = hangmanMinLength; length <= hangmanMaxLength; length++)
+    {
+        if (dictionaryIndex.hangman[length].wordIds.size() >= hangmanMinCandidates)
+        {
+            lengths.push_back(length);
+        }
+    }
+    if (lengths.empty())
+    {
+        cout << "No hangman words can be made from the loaded words.\n";
+        return;
+    }
+    size_t length = lengths[static_cast<size_t>(rand()) % lengths.size()];
+    const HangmanBucket &bucket = dictionaryIndex.hangman[length];
+
+    // Every word of that length is still possible
+    vector<uint32_t> candidates(bucket.wordIds.size());
+    for (size_t k = 0; k < candidates.size(); k++)
+    {
+        candidates[k] = static_cast<uint32_t>(k);
+    }
+
+    // Explain the round
+    cout << "\nEvil Hangman: guess the " << length << "-letter word one letter at a time.\n";
+    cout << "You can make " << hangmanLives << " wrong guesses. Watch out, the word may not be what you think!\n";
+
+    // Play until the word is revealed or the lives run out
+    string revealed(length, '_');
+    uint32_t guessed = 0;
+    int lives = hangmanLives;
+    string entry;
+    while (lives > 0 && revealed.find('_') != string::npos)
+    {
+        // Show the board
+        cout << "Word:";
+        for (char c : revealed)
+        {
+            cout << ' ' << c;
+        }
+        cout << "   Lives: " << lives << "   Guessed:";
+        for (int letter = 0; letter < 26; letter++)
+        {
+            if (guessed & (1u << letter))
+            {
+                cout << ' ' << static_cast<char>('a' + letter);
+            }
+        }
+        cout << "\nGuess a letter: ";
+        if (!(cin >> entry))
+        {
+            break;
+        }
+
+        // Validate the letter
+        char letter = static_cast<char>(tolower(static_cast<unsigned char>(entry[0])));
+        if (entry.length() != 1 || letter < 'a' || letter > 'z')
+        {
+            cout << "Please enter a single letter.\n";
+            continue;
+        }
+        if (guessed & (1u << (letter - 'a')))
+        {
+            cout << "You already guessed '" << letter << "'.\n";
+            continue;
+        }
+        guessed |= 1u << (letter - 'a');
+
+        // Keep the largest family and show what it reveals
+        uint32_t positions = partitionHangman(bucket, length, candidates, letter);
+        if (positions == 0)
+        {
+            lives--;
+            cout << "No '" << letter << "' in the word.\n";
+            continue;
+        }
+        for (size_t i = 0; i < length; i++)
+        {
+            if (positions & (1u << i))
+            {
+                revealed[i] = letter;
+            }
+        }
+        cout << "Yes! '" << letter << "' appears " << __builtin_popcount(positions) << " time(s).\n";
+    }
+
+    // Score the round
+    if (revealed.find('_') == string::npos)
+    {
+        int points = static_cast<int>(length) + lives;
+        cout << "You beat it! The word was \"" << revealed << "\". You earned " << points << " points.\n";
+        updateScore(true, score, highestScore, points);
+    }
+    else
+    {
+        uint32_t entryShown = candidates[static_cast<size_t>(rand()) % candidates.size()];
+        cout << "Out of lives! The word was \"" << wordOf(bucket.wordIds[entryShown]) << "\".\n";
+        updateScore(false, score, highestScore, 0);
+    }
+
+    // Prompt the user to press Enter to continue
+    cout << "Press \"Enter\" to continue.\n";
+    cin.ignore();
+    cin.get();
+}
+
+// Function to build the positional bitsets for crossword patterns
+void buildPatternIndex(array<PatternBucket, patternMaxLength + 1> &buckets, const vector<uint32_t> &letterMasks, const vector<string> &text)
+{
+    // Distinct lowercase words, first by ID, grouped by length
+    vector<pair<uint64_t, uint32_t>> entries;
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        if (!text[i].empty() && text[i].length() <= patternMaxLength && (letterMasks[i] >> 31) == 0)
+        {
+            entries.push_back(make_pair(hashWord(text[i]), static_cast<uint32_t>(i)));
+        }
+    }
+    sort(entries.begin(), entries.end());
+    for (PatternBucket &bucket : buckets)
+    {
+        bucket = PatternBucket();
+    }
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        if (i == 0 || entries[i].first != entries[i - 1].first)
+        {
+            buckets[text[entries[i].second].length()].wordIds.push_back(entries[i].second);
+        }
+    }
+
+    // Set one bit per letter of every entry
+    for (size_t length = 1; length <= patternMaxLength; length++)
+    {
+        PatternBucket &bucket = buckets[length];
+        sort(bucket.wordIds.begin(), bucket.wordIds.end());
+        bucket.blocks = (bucket.wordIds.size() + 63) / 64;
+        bucket.bits.assign(length * 26 * bucket.blocks, 0);
+        for (size_t k = 0; k < bucket.wordIds.size(); k++)
+        {
+            const string &word = text[bucket.wordIds[k]];
+            for (size_t p = 0; p < length; p++)
+            {
+                bucket.bits[(p * 26 + static_cast<size_t>(word[p] - 'a')) * bucket.blocks + k / 64] |= 1ULL << (k % 64);
+            }
+        }
+    }
+}
+
+// Function to find the words that fit a crossword pattern
+// '?', '.' and '_' stand for any letter. Up to limit matching IDs are
+// listed; the return value is the full number of matches
+size_t findPatternWords(const string &pattern, vector<uint32_t> &wordIds, size_t limit)
+{
+    // Start from an empty list
+    wordIds.clear();
+    size_t length = pattern.length();
+    if (length == 0 || length > patternMaxLength)
+    {
+        return 0;
+    }
+    const PatternBucket &bucket = dictionaryIndex.patterns[length];
+
+    // Bitset of each known letter
+    vector<const uint64_t *> sets;
+    for (size_t p = 0; p < length; p++)
+    {
+        char c = static_cast<char>(tolower(static_cast<unsigned char>(pattern[p])));
+        if (c == '?' || c == '.' || c == '_')
+        {
+            continue;
+        }
+        if (c < 'a' || c > 'z')
+        {
+            return 0;
+        }
+        sets.push_back(bucket.bits.data() + (p * 26 + static_cast<size_t>(c - 'a')) * bucket.blocks);
+    }
+
+    // AND the sets one 64-word block at a time, counting and listing
+    size_t count = 0;
+    for (size_t b = 0; b < bucket.blocks; b++)
+    {
+        uint64_t match = ~0ULL;
+        for (const uint64_t *set : sets)
+        {
+            match &= set[b];
+        }
+        if (b == bucket.blocks - 1 && bucket.wordIds.size() % 64 != 0)
+        {
+            match &= (1ULL << (bucket.wordIds.size() % 64)) - 1;
+        }
+        count += static_cast<size_t>(__builtin_popcountll(match));
+        while (match != 0 && wordIds.size() < limit)
+        {
+            wordIds.push_back(bucket.wordIds[b * 64 + static_cast<size_t>(__builtin_ctzll(match))]);
+            match &= match - 1;
+        }
+    }
+    return count;
+}
+
+// Function to write a word with only some letters shown
+// Bit p of shown keeps letter p; the rest become '?'
+string blanksPattern(const string &word, uint64_t shown)
+{
+    string pattern = word;
+    for (size_t p = 0; p < pattern.length(); p++)
+    {
+        if (p >= 64 || (shown & (1ULL << p)) == 0)
+        {
+            pattern[p] = '?';
+        }
+    }
+    return pattern;
+}
+
+// Function to play one fill the blanks round
+// A word with half its letters hidden; any word that fits scores
+void playFillTheBlanks(int &score, int &highestScore)
+{
+    // Look for a pattern that fits a handful of words
+    mt19937 rng(static_cast<unsigned>(rand()));
+    string pattern;
+    size_t total = 0;
+    vector<uint32_t> answerIds;
+    for (int attempt = 0; attempt < blanksAttempts && pattern.empty(); attempt++)
+    {
+        size_t length = blanksMinLength + rng() % (blanksMaxLength - blanksMinLength + 1);
+        const PatternBucket &bucket = dictionaryIndex.patterns[length];
+        if (bucket.wordIds.empty())
+        {
+            continue;
+        }
+
+        // Show a random half of the letters
+        string word = wordOf(bucket.wordIds[rng() % bucket.wordIds.size()]);
+        vector<size_t> positions(length);
+        for (size_t p = 0; p < length; p++)
+        {
+            positions[p] = p;
+        }
+        shuffle(positions.begin(), positions.end(), rng);
+        uint64_t shown = 0;
+        for (size_t i = 0; i < length / 2; i++)
+        {
+            shown |= 1ULL << positions[i];
+        }
+        string candidate = blanksPattern(word, shown);
+        total = findPatternWords(candidate, answerIds, blanksMaxAnswers);
+        if (total >= 2 && total <= blanksMaxAnswers)
+        {
+            pattern = candidate;
+        }
+    }
+    if (pattern.empty())
+    {
+        cout << "No fill the blanks puzzles can be made from the loaded words.\n";
+        return;
+    }
+    vector<string> answers;
+    for (uint32_t id : answerIds)
+    {
+        answers.push_back(wordOf(id));
+    }
+    sort(answers.begin(), answers.end());
+
+    // Explain the puzzle
+    cout << "\nFill the Blanks: enter words that fit the pattern (? is any letter).\n";
+    cout << "  " << pattern << "\n";
+    cout << answers.size() << " dictionary words fit it.\n";
+
+    // Collect the player's words
+    vector<string> claimed;
+    vector<string> hinted;
+    int points = 0;
+    int hintsUsed = 0;
+    string entry;
+    while (claimed.size() < answers.size())
+    {
+        cout << "Enter a word (or type 'hint' for a hint, 'done' to finish): ";
+        if (!(cin >> entry) || entry == "done")
+        {
+            break;
+        }
+        transform(entry.begin(), entry.end(), entry.begin(), [](unsigned char c)
+                  { return static_cast<char>(tolower(c)); });
+
+        // Hint: fill the blanks with a word neither found nor suggested
+        // yet. Once every word left has been suggested, one is repeated
+        // free
+        if (entry == "hint")
+        {
+            const string *fresh = nullptr;
+            const string *repeated = nullptr;
+            for (const string &answer : answers)
+            {
+                if (find(claimed.begin(), claimed.end(), answer) != claimed.end())
+                {
+                    continue;
+                }
+                if (find(hinted.begin(), hinted.end(), answer) == hinted.end())
+                {
+                    fresh = &answer;
+                    break;
+                }
+                if (repeated == nullptr)
+                {
+                    repeated = &answer;
+                }
+            }
+
+            // Some word is always left here, as the loop ends when all
+            // are found
+            if (fresh == nullptr)
+            {
+                cout << "Try \"" << *repeated << "\" again. No charge for a repeated hint.\n";
+                continue;
+            }
+            if (hintsUsed >= maxHintsPerWord)
+            {
+                cout << "You have used all available hints for this pattern.\n";
+                continue;
+            }
+            hintsUsed++;
+            hinted.push_back(*fresh);
+            score -= hintCost;
+            cout << "Try \"" << *fresh << "\". Hint cost deducted. Current score: " << score << endl;
+            continue;
+        }
+
+        // Check the word against the pattern's answers
+        if (find(claimed.begin(), claimed.end(), entry) != claimed.end())
+        {
+            cout << "You already found \"" << entry << "\".\n";
+        }
+        else if (binary_search(answers.begin(), answers.end(), entry))
+        {
+            claimed.push_back(entry);
+            points += static_cast<int>(entry.length());
+            cout << "Fits! +" << entry.length() << " (" << claimed.size() << "/" << answers.size() << ")\n";
+        }
+        else
+        {
+            cout << "\"" << entry << "\" does not fit " << pattern << ".\n";
+        }
+    }
+
+    // Show how the player did and the words missed
+    cout << "You found " << claimed.size() << " of " << answers.size() << " words for " << points << " points.\n";
+    cout << "Words that fit:";
+    for (const string &answer : answers)
+    {
+        cout << " " << answer;
+    }
+    cout << endl;
+    if (points > 0)
+    {
+        updateScore(true, score, highestScore, points);
+    }
+
+    // Prompt the user to press Enter to continue
+    cout << "Press \"Enter\" to continue.\n";
+    cin.ignore();
+    cin.get();
+}
+
+// Function to save the phrases spelled by a list of classes
+// Every choice of one word per class is a phrase
+void recordPhrase(PhraseSearch &search, const vector<uint32_t> &chosen)
+{
+    lock_guard<mutex> guard(search.resultsLock);
+    vector<size_t> pick(chosen.size(), 0);
+    while (search.results.size() < search.maxResults)
+    {
+        // Spell the current choice
+        vector<uint32_t> phrase;
+        for (size_t i = 0; i < chosen.size(); i++)
+        {
+            phrase.push_back(search.classWords[chosen[i]][pick[i]]);
+        }
+        search.results.push_back(phrase);
+
+        // Step to the next choice like an odometer
+        size_t i = 0;
+        while (i < chosen.size() && ++pick[i] == search.classWords[chosen[i]].size())
+        {
+            pick[i++] = 0;
+        }
+        if (i == chosen.size())
+        {
+            break;
+        }
+    }
+    if (search.results.size() >= search.maxResults)
+    {
+        search.stop = true;
+    }
+}
+
+// Function to search for phrases using up the remaining letters
+// Classes are taken in order from start, so each phrase is found once.
+// A (remaining letters, start, words used) state that led nowhere is
+// remembered in dead and never searched again. Returns true if any
+// phrase was found below this state
+bool phraseSearchFrom(PhraseSearch &search, LetterHistogram &remaining, size_t letters, size_t start, vector<uint32_t> &chosen, unordered_set<uint64_t> &dead, size_t &steps)
+{
+    // All letters used: a phrase
+    if (letters == 0)
+    {
+        recordPhrase(search, chosen);
+        return true;
+    }
+    if (chosen.size() >= phraseMaxWords || search.stop)
+    {
+        return false;
+    }
+
+    // Check the clock now and then
+    if (++steps % 256 == 0 && chrono::steady_clock::now() > search.deadline)
+    {
+        search.stop = true;
+        return false;
+    }
+
+    // Skip states known to lead nowhere
+    uint64_t key = 1469598103934665603ULL;
+    for (int i = 0; i < 26; i++)
+    {
+        key = (key ^ remaining.counts[i]) * 1099511628211ULL;
+    }
+    key = mixHash(key, start * phraseMaxWords + chosen.size());
+    if (dead.count(key))
+    {
+        return false;
+    }
+
+    // Try every class that still fits, longest first
+    bool found = false;
+    for (size_t c = start; c < search.classHistograms.size() && !search.stop; c++)
+    {
+        if (search.classLengths[c] > letters || !histogramContains(remaining, search.classHistograms[c]))
+        {
+            continue;
+        }
+        for (size_t i = 0; i < 26; i++)
+        {
+            remaining.counts[i] -= search.classHistograms[c].counts[i];
+        }
+        chosen.push_back(static_cast<uint32_t>(c));
+        found |= phraseSearchFrom(search, remaining, letters - search.classLengths[c], c, chosen, dead, steps);
+        chosen.pop_back();
+        for (size_t i = 0; i < 26; i++)
+        {
+            remaining.counts[i] += search.classHistograms[c].counts[i];
+        }
+    }
+
+    // Only a finished search proves a dead end
+    if (!found && !search.stop)
+    {
+        dead.insert(key);
+    }
+    return found;
+}
+
+// Function to find phrases of dictionary words with the same letters
+// as the input ("dormitory" -> "dirty room"). Spaces and punctuation
+// are ignored. Stops after maxResults phrases or timeLimitMs
+// milliseconds; the first words are split across all cores
+size_t findPhraseAnagrams(const string &phrase, size_t maxResults, int timeLimitMs, vector<vector<uint32_t>> &phrases)
+{
+    // Letters of the input
+    phrases.clear();
+    string letters;
+    for (char c : phrase)
+    {
+        char lower = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+        if (lower >= 'a' && lower <= 'z')
+        {
+            letters.push_back(lower);
+        }
+    }
+    if (letters.empty() || maxResults == 0)
+    {
+        return 0;
+    }
+    LetterHistogram target = computeHistogram(letters);
+
+    // Words spelled from those letters, grouped into classes
+    PhraseSearch search;
+    search.maxResults = maxResults;
+    search.deadline = chrono::steady_clock::now() + chrono::milliseconds(timeLimitMs);
+    vector<uint32_t> fits;
+    findContainedHistograms(dictionaryIndex.histograms, target, fits);
+    unordered_map<uint64_t, size_t> classOf;
+    for (uint32_t id : fits)
+    {
+        string word = wordOf(id);
+        if (word.length() < phraseMinWordLength)
+        {
+            continue;
+        }
+        uint64_t key = hashWord(string(reinterpret_cast<const char *>(dictionaryIndex.histograms[id].counts), 27));
+        auto found = classOf.find(key);
+        if (found == classOf.end())
+        {
+            found = classOf.insert(make_pair(key, search.classWords.size())).first;
+            search.classHistograms.push_back(dictionaryIndex.histograms[id]);
+            search.classLengths.push_back(word.length());
+            search.classWords.push_back(vector<uint32_t>());
+        }
+        vector<uint32_t> &members = search.classWords[found->second];
+        if (none_of(members.begin(), members.end(), [&](uint32_t other)
+                    { return wordOf(other) == word; }))
+        {
+            members.push_back(id);
+        }
+    }
+
+    // Longest words first; long words use up letters fastest
+    vector<size_t> order(search.classLengths.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        order[i] = i;
+    }
+    stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+                { return search.classLengths[a] > search.classLengths[b]; });
+    PhraseSearch sorted;
+    for (size_t i : order)
+    {
+        sorted.classHistograms.push_back(search.classHistograms[i]);
+        sorted.classLengths.push_back(search.classLengths[i]);
+        sorted.classWords.push_back(search.classWords[i]);
+    }
+    search.classHistograms.swap(sorted.classHistograms);
+    search.classLengths.swap(sorted.classLengths);
+    search.classWords.swap(sorted.classWords);
+
+    // Each worker takes a stripe of first words with its own memo
+    size_t classCount = search.classLengths.size();
+    size_t threadCount = max<size_t>(1, min<size_t>(thread::hardware_concurrency(), classCount));
+    vector<thread> workers;
+    for (size_t t = 0; t < threadCount; t++)
+    {
+        workers.emplace_back([&, t]()
+                             {
+            unordered_set<uint64_t> dead;
+            vector<uint32_t> chosen;
+            size_t steps = 0;
+            LetterHistogram remaining = target;
+            for (size_t c = t; c < classCount && !search.stop; c += threadCount)
+            {
+                if (!histogramContains(remaining, search.classHistograms[c]))
+                {
+                    continue;
+                }
+                for (size_t i = 0; i < 26; i++)
+                {
+                    remaining.counts[i] -= search.classHistograms[c].counts[i];
+                }
+                chosen.push_back(static_cast<uint32_t>(c));
+                phraseSearchFrom(search, remaining, letters.length() - search.classLengths[c], c, chosen, dead, steps);
+                chosen.pop_back();
+                remaining = target;
+            } });
+    }
+    for (thread &worker : workers)
+    {
+        worker.join();
+    }
+
+    phrases.swap(search.results);
+    return phrases.size();
+}
+
+// Function to play one phrase jumble
+// Two words' letters are mixed together; any phrase of dictionary
+// words that uses exactly those letters solves it
+void playPhraseJumble(int &score, int &highestScore)
+{
+    // Pick two words of jumble length
+    vector<uint32_t> pool;
+    const WordStore &words = *dictionaryIndex.words;
+    for (size_t i = 0; i < words.lengths.size(); i++)
+    {
+        if (words.lengths[i] >= jumbleMinLength && words.lengths[i] <= jumbleMaxLength &&
+            (dictionaryIndex.letterMasks[i] >> 31) == 0)
+        {
+            pool.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    if (pool.size() < 2)
+    {
+        cout << "No phrase jumbles can be made from the loaded words.\n";
+        return;
+    }
+    string first = wordOf(pool[static_cast<size_t>(rand()) % pool.size()]);
+    string second = wordOf(pool[static_cast<size_t>(rand()) % pool.size()]);
+    string letters = first + second;
+    size_t jumbleArena = wordArena.size();
+    string jumble(wordView(scrambleWord(makeWord(letters.data(), letters.length()))));
+    wordArena.resize(jumbleArena);
+    LetterHistogram target = computeHistogram(letters);
+
+    // Explain the puzzle
+    cout << "\nPhrase Jumble: use all of these letters to spell two or more words.\n";
+    cout << "  " << jumble << "\n";
+
+    // Read whole lines; the first may be left over from the menu
+    int attemptsLeft = 3;
+    int hintsUsed = 0;
+    bool solved = false;
+    string line;
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    while (attemptsLeft > 0 && !solved)
+    {
+        cout << "Enter your phrase (or type 'hint' for a hint): ";
+        if (!getline(cin, line))
+        {
+            break;
+        }
+        if (line.find_first_not_of(" \t\r") == string::npos)
+        {
+            continue;
+        }
+
+        // Split into lowercase words
+        vector<string> guessWords;
+        string current;
+        for (char c : line + " ")
+        {
+            if (isspace(static_cast<unsigned char>(c)))
+            {
+                if (!current.empty())
+                {
+                    guessWords.push_back(current);
+                    current.clear();
+                }
+            }
+            else
+            {
+                current.push_back(static_cast<char>(tolower(static_cast<unsigned char>(c))));
+            }
+        }
+
+        // Hint: the first word of a phrase the solver finds
+        if (guessWords.size() == 1 && guessWords[0] == "hint")
+        {
+            if (hintsUsed >= maxHintsPerWord)
+            {
+                cout << "You have used all available hints for this jumble.\n";
+                continue;
+            }
+            hintsUsed++;
+            score -= hintCost;
+            vector<vector<uint32_t>> phrases;
+            findPhraseAnagrams(letters, 1, phraseHintTimeMs, phrases);
+            string hint = phrases.empty() ? first : wordOf(phrases[0][hintsUsed == 1 ? 0 : phrases[0].size() - 1]);
+            cout << "One phrase uses \"" << hint << "\". Hint cost deducted. Current score: " << score << endl;
+            continue;
+        }
+
+        // Every word must be real and the letters must match exactly
+        bool allWords = guessWords.size() >= 2;
+        string joined;
+        for (const string &word : guessWords)
+        {
+            allWords = allWords && isDictionaryWord(word);
+            joined += word;
+        }
+        if (allWords && histogramsEqual(computeHistogram(joined), target))
+        {
+            solved = true;
+        }
+        else
+        {
+            attemptsLeft--;
+            cout << (allWords ? "Those words don't use exactly the jumbled letters." : "Use two or more dictionary words.")
+                 << " Attempts left: " << attemptsLeft << endl;
+        }
+    }
+
+    // Score the jumble and show some phrases
+    if (solved)
+    {
+        int points = static_cast<int>(letters.length());
+        cout << "Solved! You earned " << points << " points.\n";
+        updateScore(true, score, highestScore, points);
+    }
+    else
+    {
+        updateScore(false, score, highestScore, 0);
+    }
+    vector<vector<uint32_t>> phrases;
+    findPhraseAnagrams(letters, phraseMaxResults, phraseTimeLimitMs, phrases);
+    cout << "Some phrases from these letters:";
+    if (phrases.empty())
+    {
+        cout << " " << first << " " << second;
+    }
+    for (size_t i = 0; i < phrases.size(); i++)
+    {
+        cout << (i == 0 ? " " : ", ");
+        for (size_t w = 0; w < phrases[i].size(); w++)
+        {
+            cout << (w == 0 ? "" : " ") << wordOf(phrases[i][w]);
+        }
+    }
+    cout << endl;
+
+    // Prompt the user to press Enter to continue
+    cout << "Press \"Enter\" to continue.\n";
+    cin.get();
+}
+
+// Function to count the days from 1970-01-01 to a calendar date
+// Proleptic Gregorian calendar, in 400-year eras
+int64_t daysFromCivil(int year, int month, int day)
+{
+    int64_t y = year - (month <= 2 ? 1 : 0);
+    int64_t era = (y >= 0 ? y : y - 399) / 400;
+    int64_t yearOfEra = y - era * 400;
+    int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+// Function to read a YYYY-MM-DD date as a day number
+bool parseDate(const string &text, int64_t &day)
+{
+    int year = 0;
+    int month = 0;
+    int dayOfMonth = 0;
+    if (sscanf(text.c_str(), "%d-%d-%d", &year, &month, &dayOfMonth) != 3 || month < 1 || month > 12 ||
+        dayOfMonth < 1 || dayOfMonth > 31)
+    {
+        return false;
+    }
+    day = daysFromCivil(year, month, dayOfMonth);
+    return true;
+}
+
+// Function to get the local date as a day number
+int64_t today()
+{
+    time_t now = time(0);
+    tm local = *localtime(&now);
+    return daysFromCivil(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday);
+}
+
+// Function to precompute a run of daily puzzles into a calendar file
+// Each day draws from its own generator seeded by (seed, day), so a
+// day's puzzle never depends on the range it was generated in.
+// Weekdays set the difficulty: easy Monday and Tuesday, medium
+// Wednesday to Friday, hard at the weekend
+bool generateCalendar(uint64_t seed, int64_t firstDay, uint32_t dayCount, const string &filename)
+{
+    // Words each difficulty can use
+    const WordStore &words = *dictionaryIndex.words;
+    array<vector<uint32_t>, 4> pools;
+    for (int difficulty = 1; difficulty <= 3; difficulty++)
+    {
+        vector<uint32_t> filteredIds;
+        filterWordsByDifficulty(filteredIds, words, difficulty);
+        for (uint32_t id : filteredIds)
+        {
+            if (words.lengths[id] <= calendarMaxLength && (dictionaryIndex.letterMasks[id] >> 31) == 0)
+            {
+                pools[difficulty].push_back(id);
+            }
+        }
+    }
+
+    vector<CalendarPuzzle> puzzles(dayCount);
+    for (uint32_t d = 0; d < dayCount; d++)
+    {
+        // Day 0 (1970-01-01) was a Thursday; 0 is Sunday here
+        int64_t day = firstDay + d;
+        int weekday = static_cast<int>(((day + 4) % 7 + 7) % 7);
+        int difficulty = weekday == 1 || weekday == 2 ? 1 : weekday >= 3 && weekday <= 5 ? 2 : 3;
+        mt19937_64 rng(mixHash(seed, static_cast<uint64_t>(day)));
+
+        // Vet words until one has a scramble that is not a word itself.
+        // A pool that yields none within a few draws per word is given up
+        // for the day, falling back to medium, easy, then hard
+        array<bool, 4> spent = {true, false, false, false};
+        uint32_t id = noWordId;
+        string word;
+        string scramble;
+        bool vetted = false;
+        while (!vetted)
+        {
+            if (spent[difficulty] || pools[difficulty].empty())
+            {
+                spent[difficulty] = true;
+                difficulty = !spent[2] && !pools[2].empty() ? 2 : !spent[1] && !pools[1].empty() ? 1 : 3;
+            }
+            if (spent[difficulty] || pools[difficulty].empty())
+            {
+                return false;
+            }
+            const vector<uint32_t> &pool = pools[difficulty];
+            for (size_t draw = 0; draw < pool.size() * calendarDrawsPerWord && !vetted; draw++)
+            {
+                id = pool[rng() % pool.size()];
+                word = wordOf(id);
+                scramble = word;
+                for (int attempt = 0; attempt < calendarScrambleTries && !vetted; attempt++)
+                {
+                    shuffle(scramble.begin(), scramble.end(), rng);
+                    vetted = scramble != word && !isDictionaryWord(scramble);
+                }
+            }
+            spent[difficulty] = !vetted;
+        }
+
+        // Store the puzzle with its best letter hints
+        CalendarPuzzle &puzzle = puzzles[d];
+        puzzle = CalendarPuzzle();
+        puzzle.wordId = id;
+        puzzle.difficulty = static_cast<uint8_t>(difficulty);
+        puzzle.length = static_cast<uint8_t>(word.length());
+        memcpy(puzzle.scramble, scramble.data(), scramble.length());
+        HintPlan plan = planHints(id);
+        for (size_t h = 0; h < calendarHints; h++)
+        {
+            puzzle.hintPositions[h] = static_cast<uint8_t>(h < plan.order.size() ? plan.order[h] : 0xFF);
+        }
+    }
+
+    // Header, then one record per day
+    CalendarHeader header = {calendarMagic, dayCount, firstDay, seed, wordStoreSize(words), wordListFingerprint(words, wordStoreSize(words))};
+    ofstream out(filename, ios::binary);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(puzzles.data()), static_cast<streamsize>(puzzles.size() * sizeof(CalendarPuzzle)));
+    return static_cast<bool>(out);
+}
+
+// Function to play today's puzzle from the calendar file
+// Serving is one indexed read from the mapped file
+void playDailyChallenge(int &score, int &highestScore)
+{
+    // Map the calendar and check it was built from the loaded words;
+    // words added after them do not move their IDs
+    MappedFile calendar;
+    CalendarHeader header = {};
+    if (mapFile(calendar, calendarFile) && calendar.size >= sizeof(header))
+    {
+        memcpy(&header, calendar.data, sizeof(header));
+    }
+    int64_t index = today() - header.firstDay;
+    const WordStore &words = *dictionaryIndex.words;
+    if (header.magic != calendarMagic || calendar.size != sizeof(header) + header.dayCount * sizeof(CalendarPuzzle) ||
+        header.wordCount > wordStoreSize(words) || index < 0 || index >= header.dayCount ||
+        header.fingerprint != wordListFingerprint(words, header.wordCount))
+    {
+        cout << "There is no daily challenge for today. Run with --calendar to generate one.\n";
+        unmapFile(calendar);
+        return;
+    }
+
+    // Today's record
+    CalendarPuzzle puzzle;
+    memcpy(&puzzle, calendar.data + sizeof(header) + static_cast<size_t>(index) * sizeof(CalendarPuzzle), sizeof(puzzle));
+    unmapFile(calendar);
+    string scramble(puzzle.scramble, puzzle.length);
+    string word = wordOf(puzzle.wordId);
+    if (!isAnagramOf(scramble, puzzle.wordId))
+    {
+        cout << "Today's challenge does not match the loaded words.\n";
+        return;
+    }
+
+    // Show the puzzle
+    static const char *const difficultyNames[] = {"", "Easy", "Medium", "Hard"};
+    cout << "\nDaily Challenge (" << difficultyNames[puzzle.difficulty] << "): everyone gets the same word today.\n";
+    cout << "Anagram of the word is: " << scramble << endl;
+
+    // Three attempts; hints reveal the stored positions in order
+    int attemptsLeft = 3;
+    size_t hintsUsed = 0;
+    bool solved = false;
+    string guess;
+    while (attemptsLeft > 0 && !solved)
+    {
+        cout << "Guess the word (or type 'hint' for a hint): ";
+        if (!(cin >> guess))
+        {
+            break;
+        }
+        if (guess == "hint")
+        {
+            if (hintsUsed >= calendarHints || puzzle.hintPositions[hintsUsed] >= puzzle.length)
+            {
+                cout << "You have used all available hints for this word.\n";
+                continue;
+            }
+            size_t position = puzzle.hintPositions[hintsUsed++];
+            score -= hintCost;
+            cout << "Revealed letter at position " << position + 1 << ": " << word[position]
+                 << ". Hint cost deducted. Current score: " << score << endl;
+            continue;
+        }
+        // Everyone is solving the same word, so only that word wins
+        solved = guess == word;
+        if (!solved)
+        {
+            attemptsLeft--;
+            cout << "Incorrect guess. Attempts left: " << attemptsLeft << endl;
+        }
+    }
+
+    // Harder days are worth more
+    if (solved)
+    {
+        int points = static_cast<int>(word.length()) * puzzle.difficulty;
+        cout << "Correct! You earned " << points << " points. Come back tomorrow for a new word.\n";
+        updateScore(true, score, highestScore, points);
+    }
+    else
+    {
+        cout << "Out of attempts! Today's word was \"" << word << "\".\n";
+        updateScore(false, score, highestScore, 0);
+    }
+
+    // Prompt the user to press Enter to continue
+    cout << "Press \"Enter\" to continue.\n";
+    cin.ignore();
+    cin.get();
+}
+
+// Function to build a Fenwick tree over a list of values in O(N)
+// Each node adds itself into its parent once
+void fenwickBuild(vector<double> &tree, const vector<double> &values)
+{
+    tree.assign(values.size() + 1, 0.0);
+    for (size_t i = 1; i < tree.size(); i++)
+    {
+        tree[i] += values[i - 1];
+        size_t parent = i + (i & (~i + 1));
+        if (parent < tree.size())
+        {
+            tree[parent] += tree[i];
+        }
+    }
+}
+
+// Function to add delta to the value at a 0-based position
+void fenwickAdd(vector<double> &tree, size_t position, double delta)
+{
+    for (size_t i = position + 1; i < tree.size(); i += i & (~i + 1))
+    {
+        tree[i] += delta;
+    }
+}
+
+// Function to sum the first count values
+double fenwickPrefix(const vector<double> &tree, size_t count)
+{
+    double sum = 0.0;
+    for (size_t i = count; i > 0; i -= i & (~i + 1))
+    {
+        sum += tree[i];
+    }
+    return sum;
+}
+
+// Function to find the first 0-based position whose prefix sum
+// (including itself) passes target, by descending the tree's bits
+size_t fenwickFind(const vector<double> &tree, double target)
+{
+    size_t position = 0;
+    size_t step = 1;
+    while (step * 2 < tree.size())
+    {
+        step *= 2;
+    }
+    for (; step > 0; step /= 2)
+    {
+        if (position + step < tree.size() && tree[position + step] <= target)
+        {
+            position += step;
+            target -= tree[position];
+        }
+    }
+    return position;
+}
+
+// Function to fit a player profile to the loaded words
+// Weights already learned are kept; new words start at 1
+void syncPlayerProfile(PlayerProfile &profile)
+{
+    size_t wordCount = dictionaryIndex.byLength.size();
+    if (profile.weights.size() == wordCount && profile.tree.size() == wordCount + 1)
+    {
+        return;
+    }
+    profile.weights.resize(wordCount, 1.0f);
+
+    // Lay the weights out in length order and build the tree
+    vector<double> values(wordCount);
+    for (size_t rank = 0; rank < wordCount; rank++)
+    {
+        values[rank] = profile.weights[dictionaryIndex.byLength[rank]];
+    }
+    fenwickBuild(profile.tree, values);
+}
+
+// Function to predict how likely the player is to solve a word
+// A logistic curve: even odds at the player's skill length
+double adaptiveSolveChance(const PlayerProfile &profile, size_t length)
+{
+    return 1.0 / (1.0 + exp((static_cast<double>(length) - profile.skill) / adaptiveLengthScale));
+}
+
+// Function to sample a word matched to the player
+// The length whose predicted solve chance is nearest the target is
+// chosen, then a word of that length is drawn by weight, so missed
+// words come back more often than solved ones
+uint32_t pickAdaptiveWord(PlayerProfile &profile)
+{
+    syncPlayerProfile(profile);
+    const vector<uint32_t> &starts = dictionaryIndex.lengthStarts;
+    if (starts.empty())
+    {
+        return noWordId;
+    }
+
+    // Length nearest the target chance; ties are broken at random
+    size_t bestLength = 0;
+    double bestGap = 2.0;
+    int ties = 0;
+    for (size_t length = easyMinLength; length + 1 < starts.size(); length++)
+    {
+        if (starts[length + 1] == starts[length])
+        {
+            continue;
+        }
+        double gap = fabs(adaptiveSolveChance(profile, length) - adaptiveTargetSolveRate);
+        if (gap < bestGap - 1e-9)
+        {
+            bestLength = length;
+            bestGap = gap;
+            ties = 1;
+        }
+        else if (gap < bestGap + 1e-9 && rand() % ++ties == 0)
+        {
+            bestLength = length;
+        }
+    }
+    if (bestLength == 0)
+    {
+        return noWordId;
+    }
+
+    // Draw by weight within that length's range of the tree
+    size_t first = starts[bestLength];
+    size_t last = starts[bestLength + 1];
+    double low = fenwickPrefix(profile.tree, first);
+    double high = fenwickPrefix(profile.tree, last);
+    double target = low + (high - low) * (static_cast<double>(rand()) / (static_cast<double>(RAND_MAX) + 1.0));
+    size_t rank = min(max(fenwickFind(profile.tree, target), first), last - 1);
+    return dictionaryIndex.byLength[rank];
+}
+
+// Function to learn from a finished round
+// The skill moves toward the result by how surprising it was, and
+// the word's weight shrinks when solved and grows when missed
+void recordAdaptiveResult(PlayerProfile &profile, uint32_t wordId, bool solved)
+{
+    syncPlayerProfile(profile);
+    if (wordId >= profile.weights.size())
+    {
+        return;
+    }
+    double chance = adaptiveSolveChance(profile, dictionaryIndex.words->lengths[wordId]);
+    profile.skill += adaptiveLearningRate * ((solved ? 1.0 : 0.0) - chance);
+
+    // Update the weight and its place in the tree
+    float weight = profile.weights[wordId] * (solved ? adaptiveSolvedFactor : adaptiveMissedFactor);
+    weight = min(max(weight, 1.0f / adaptiveMaxWeight), adaptiveMaxWeight);
+    fenwickAdd(profile.tree, dictionaryIndex.lengthRank[wordId], static_cast<double>(weight) - profile.weights[wordId]);
+    profile.weights[wordId] = weight;
+}
+
+// Function to store a review item in a heap slot and remember where
+void placeReview(PlayerProfile &profile, size_t slot, const ReviewItem &item)
+{
+    profile.reviews[slot] = item;
+    profile.reviewSlots[item.wordId] = slot;
+}
+
+// Function to move the item in a slot up or down until the heap is
+// ordered again. Each step compares against at most reviewHeapArity
+// children, so both directions take O(log N)
+void siftReview(PlayerProfile &profile, size_t slot)
+{
+    vector<ReviewItem> &heap = profile.reviews;
+    ReviewItem item = heap[slot];
+
+    // Up while the parent is due later
+    while (slot > 0 && heap[(slot - 1) / reviewHeapArity].due > item.due)
+    {
+        size_t parent = (slot - 1) / reviewHeapArity;
+        placeReview(profile, slot, heap[parent]);
+        slot = parent;
+    }
+
+    // Down while a child is due sooner
+    while (true)
+    {
+        size_t first = slot * reviewHeapArity + 1;
+        size_t best = slot;
+        ReviewItem bestItem = item;
+        for (size_t child = first; child < first + reviewHeapArity && child < heap.size(); child++)
+        {
+            if (heap[child].due < bestItem.due)
+            {
+                best = child;
+                bestItem = heap[child];
+            }
+        }
+        if (best == slot)
+        {
+            break;
+        }
+        placeReview(profile, slot, bestItem);
+        slot = best;
+    }
+    placeReview(profile, slot, item);
+}
+
+// Function to start a round and get the word due for review, if any
+// Only the top of the heap is looked at; the word stays scheduled
+// until updateReview records how the round went
+uint32_t dueReviewWord(PlayerProfile &profile)
+{
+    profile.rounds++;
+    if (profile.reviews.empty() || profile.reviews[0].due > profile.rounds)
+    {
+        return noWordId;
+    }
+    return profile.reviews[0].wordId;
+}
+
+// Function to reschedule a word after a round
+// A miss brings the word back after reviewFirstInterval rounds; a solve
+// spaces it out by reviewGrowthFactor until it is retired
+void updateReview(PlayerProfile &profile, uint32_t wordId, bool solved)
+{
+    auto found = profile.reviewSlots.find(wordId);
+    if (found == profile.reviewSlots.end())
+    {
+        // Only missed words join the schedule
+        if (!solved)
+        {
+            profile.reviews.push_back(ReviewItem{profile.rounds + reviewFirstInterval, wordId, reviewFirstInterval});
+            siftReview(profile, profile.reviews.size() - 1);
+        }
+        return;
+    }
+    size_t slot = found->second;
+    ReviewItem item = profile.reviews[slot];
+    item.interval = solved ? static_cast<uint32_t>(ceil(item.interval * reviewGrowthFactor)) : reviewFirstInterval;
+
+    // Retire a word spaced out far enough
+    if (item.interval > reviewMaxInterval)
+    {
+        profile.reviewSlots.erase(found);
+        ReviewItem last = profile.reviews.back();
+        profile.reviews.pop_back();
+        if (slot < profile.reviews.size())
+        {
+            placeReview(profile, slot, last);
+            siftReview(profile, slot);
+        }
+        return;
+    }
+    item.due = profile.rounds + item.interval;
+    profile.reviews[slot] = item;
+    siftReview(profile, slot);
+}
+
+// Function to give words not rated yet a rating from their length, or
+// from their precomputed difficulty when the frequency table has them.
+// Ratings already learned are kept. Only called while indexes are
+// built, never during a round
+void syncWordRatings(const WordStore &words)
+{
+    size_t wordCount = wordStoreSize(words);
+    if (wordRatings.size() == wordCount)
+    {
+        return;
+    }
+    vector<atomic<float>> ratings(wordCount);
+    for (size_t i = 0; i < wordCount; i++)
+    {
+        const FrequencyEntry *entry = frequencyEntry(static_cast<uint32_t>(i));
+        double length = entry != nullptr ? entry->ratedLength : words.lengths[i];
+        double rating = eloBaseRating + eloPerLetter * (length - eloBaseLength);
+        ratings[i].store(i < wordRatings.size() ? wordRatings[i].load(memory_order_relaxed) : static_cast<float>(rating), memory_order_relaxed);
+    }
+    wordRatings.swap(ratings);
+}
+
+// Function to read a word's rating
+double wordRating(uint32_t wordId)
+{
+    return wordRatings[wordId].load(memory_order_relaxed);
+}
+
+// Function to turn a rating into the word length it plays like
+// Inverse of the starting ratings, so an unplayed word plays like its
+// own length
+size_t ratedLength(double rating)
+{
+    return static_cast<size_t>(max(1L, lround((rating - eloBaseRating) / eloPerLetter + eloBaseLength)));
+}
+
+// Function to update the player's and the word's ratings after a round
+// A solve is a win for the player and a loss for the word. The word's
+// rating is shared, so it changes by compare-and-swap: concurrent
+// rounds on a hot word each add their own delta and none is lost
+void recordRatedResult(PlayerProfile &profile, uint32_t wordId, bool solved)
+{
+    if (wordId >= wordRatings.size())
+    {
+        return;
+    }
+    atomic<float> &rating = wordRatings[wordId];
+    float current = rating.load(memory_order_relaxed);
+    double expected = 1.0 / (1.0 + pow(10.0, (current - profile.rating) / 400.0));
+    double surprise = (solved ? 1.0 : 0.0) - expected;
+    profile.rating += eloPlayerK * surprise;
+
+    // Retry against the latest rating if another round got there first
+    while (!rating.compare_exchange_weak(current, current - static_cast<float>(eloWordK * surprise), memory_order_relaxed))
+    {
+    }
+}
+
+#ifdef UNSCRAMBLE_X86_SIMD
+// AVX2 kernel: flag the ASCII letters of 64 bytes
+// (c | 0x20) - 'a' is below 26 exactly for letters; flipping the top
+// bit turns that unsigned test into a signed compare
+__attribute__((target("avx2"))) uint64_t letterBitmapAvx2(const char *block)
+{
+    uint64_t bitmap = 0;
+    for (int half = 0; half < 2; half++)
+    {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + half * 32));
+        __m256i offset = _mm256_sub_epi8(_mm256_or_si256(bytes, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+        __m256i letters = _mm256_cmpgt_epi8(_mm256_set1_epi8(26 - 128), _mm256_xor_si256(offset, _mm256_set1_epi8(-128)));
+        bitmap |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(letters))) << (half * 32);
+    }
+    return bitmap;
+}
+#endif
+
+// Function to flag the ASCII letters of 64 bytes, one bit per byte
+uint64_t letterBitmap(const char *block)
+{
+#ifdef UNSCRAMBLE_X86_SIMD
+    // Vector kernel when the CPU has it
+    if (cpuHasAvx2())
+    {
+        return letterBitmapAvx2(block);
+    }
+#endif
+
+    // Scalar fallback
+    uint64_t bitmap = 0;
+    for (size_t i = 0; i < 64; i++)
+    {
+        bitmap |= static_cast<uint64_t>(static_cast<uint8_t>((block[i] | 0x20) - 'a') < 26) << i;
+    }
+    return bitmap;
+}
+
+// Function to count a word in a sketch and return its new estimate
+uint64_t sketchAdd(CountMinSketch &sketch, uint64_t hash)
+{
+    uint64_t estimate = numeric_limits<uint64_t>::max();
+    for (size_t row = 0; row < ingestSketchDepth; row++)
+    {
+        uint32_t &cell = sketch.cells[row * sketch.width + (mixHash(hash, row) & (sketch.width - 1))];
+        cell += cell != numeric_limits<uint32_t>::max();
+        estimate = min<uint64_t>(estimate, cell);
+    }
+    return estimate;
+}
+
+// Function to estimate how often a word was counted in a sketch
+uint64_t sketchEstimate(const CountMinSketch &sketch, uint64_t hash)
+{
+    uint64_t estimate = numeric_limits<uint64_t>::max();
+    for (size_t row = 0; row < ingestSketchDepth; row++)
+    {
+        estimate = min<uint64_t>(estimate, sketch.cells[row * sketch.width + (mixHash(hash, row) & (sketch.width - 1))]);
+    }
+    return estimate;
+}
+
+// Function to empty a worker's local table
+void clearIngestTable(IngestWorker &worker)
+{
+    worker.slots.assign(ingestLocalSlots, IngestSlot());
+    worker.letters.clear();
+    worker.used = 0;
+}
+
+// Function to find a word's count in a worker's local table, adding the
+// word with a count of 0 if it is new. Linear probing from the hash;
+// the letters are only compared when the hash and length match
+uint64_t &ingestSlot(IngestWorker &worker, uint64_t hash, const char *word, size_t length)
+{
+    size_t index = hash & (ingestLocalSlots - 1);
+    while (worker.slots[index].length != 0)
+    {
+        IngestSlot &slot = worker.slots[index];
+        if (slot.hash == hash && slot.length == length && memcmp(worker.letters.data() + slot.offset, word, length) == 0)
+        {
+            return slot.count;
+        }
+        index = (index + 1) & (ingestLocalSlots - 1);
+    }
+    IngestSlot &slot = worker.slots[index];
+    slot.hash = hash;
+    slot.offset = static_cast<uint32_t>(worker.letters.size());
+    slot.length = static_cast<uint8_t>(length);
+    worker.letters.append(word, length);
+    worker.used++;
+    return slot.count;
+}
+
+// Function to merge a worker's local counts into the shared shards
+// Entries are grouped by shard first, so each shard is locked once
+void flushIngestTable(IngestWorker &worker, vector<IngestShard> &shards)
+{
+    vector<vector<const IngestSlot *>> byShard(ingestShards);
+    for (const IngestSlot &slot : worker.slots)
+    {
+        if (slot.length != 0)
+        {
+            byShard[slot.hash >> 58].push_back(&slot);
+        }
+    }
+    for (size_t shard = 0; shard < ingestShards; shard++)
+    {
+        lock_guard<mutex> guard(shards[shard].lock);
+        for (const IngestSlot *slot : byShard[shard])
+        {
+            shards[shard].counts[worker.letters.substr(slot->offset, slot->length)] += slot->count;
+        }
+    }
+    clearIngestTable(worker);
+}
+
+// Function to keep only a worker's ingestHeavyHitters strongest
+// candidates and raise the bar for new ones to the weakest kept
+void pruneIngestTable(IngestWorker &worker)
+{
+    vector<uint64_t> estimates;
+    for (const IngestSlot &slot : worker.slots)
+    {
+        if (slot.length != 0)
+        {
+            estimates.push_back(slot.count);
+        }
+    }
+    nth_element(estimates.begin(), estimates.begin() + ingestHeavyHitters, estimates.end(), greater<uint64_t>());
+    worker.threshold = estimates[ingestHeavyHitters] + 1;
+
+    // Rebuild the table from the survivors
+    IngestWorker kept;
+    kept.letters.reserve(worker.letters.size());
+    clearIngestTable(kept);
+    for (const IngestSlot &slot : worker.slots)
+    {
+        if (slot.length != 0 && slot.count >= worker.threshold)
+        {
+            ingestSlot(kept, slot.hash, worker.letters.data() + slot.offset, slot.length) = slot.count;
+        }
+    }
+    worker.slots.swap(kept.slots);
+    worker.letters.swap(kept.letters);
+    worker.used = kept.used;
+}
+
+// Function to count one lowercase token
+// Exact mode counts in the worker's local table and merges it into the
+// shards when it fills. Bounded mode counts in the worker's sketch and
+// keeps only words whose estimate reaches the current threshold in the
+// table; when the table fills, the weaker half is dropped
+void ingestToken(IngestWorker &worker, vector<IngestShard> &shards, const string &token)
+{
+    worker.tokens++;
+    uint64_t hash = hashWord(token);
+
+    // Bounded mode
+    if (!worker.sketch.cells.empty())
+    {
+        uint64_t estimate = sketchAdd(worker.sketch, hash);
+        if (estimate >= worker.threshold)
+        {
+            ingestSlot(worker, hash, token.data(), token.length()) = estimate;
+            if (worker.used >= 2 * ingestHeavyHitters)
+            {
+                pruneIngestTable(worker);
+            }
+        }
+        return;
+    }
+
+    // Exact mode
+    ingestSlot(worker, hash, token.data(), token.length())++;
+    if (worker.used >= 2 * ingestHeavyHitters)
+    {
+        flushIngestTable(worker, shards);
+    }
+}
+
+// Function to tokenize bytes [begin, end) of a corpus
+// Tokens are runs of ASCII letters, found 64 bytes at a time from the
+// letter bitmap; runs touching a non-ASCII byte are skipped so accented
+// words are not cut into fragments. The range must not split a run
+void ingestRange(IngestWorker &worker, vector<IngestShard> &shards, const char *data, size_t begin, size_t end)
+{
+    // Count the run from tokenStart to tokenEnd if it is a whole ASCII word
+    string token;
+    size_t tokenStart = 0;
+    bool open = false;
+    auto closeToken = [&](size_t tokenEnd)
+    {
+        open = false;
+        size_t length = tokenEnd - tokenStart;
+        bool ascii = (tokenStart == 0 || (data[tokenStart - 1] & 0x80) == 0) && (tokenEnd >= end || (data[tokenEnd] & 0x80) == 0);
+        if (ascii && length >= ingestMinLength && length <= ingestMaxLength)
+        {
+            token.assign(data + tokenStart, length);
+            for (char &c : token)
+            {
+                c |= 0x20;
+            }
+            ingestToken(worker, shards, token);
+        }
+    };
+
+    char tail[64];
+    for (size_t base = begin; base < end; base += 64)
+    {
+        // Classify the block; the last one is padded with spaces
+        const char *block = data + base;
+        if (end - base < 64)
+        {
+            memset(tail, ' ', sizeof(tail));
+            memcpy(tail, block, end - base);
+            block = tail;
+        }
+        uint64_t bitmap = letterBitmap(block);
+
+        // Walk the runs: the next clear bit ends a run, the next set
+        // bit starts one
+        size_t offset = 0;
+        while (true)
+        {
+            if (open)
+            {
+                uint64_t gaps = ~bitmap & (~0ULL << offset);
+                if (gaps == 0)
+                {
+                    break;
+                }
+                offset = static_cast<size_t>(__builtin_ctzll(gaps));
+                closeToken(base + offset);
+            }
+            uint64_t starts = bitmap & (~0ULL << offset);
+            if (starts == 0)
+            {
+                break;
+            }
+            offset = static_cast<size_t>(__builtin_ctzll(starts));
+            tokenStart = base + offset;
+            open = true;
+        }
+    }
+
+    // A word running to the end of the range
+    if (open)
+    {
+        closeToken(end);
+    }
+}
+
+// Function to count the words of a text corpus and write them as a
+// dictionary, most frequent first, so a word's line is its frequency
+// rank. The corpus is mapped and split across all cores. With
+// sketchMegabytes 0 every word is counted exactly in a sharded table;
+// otherwise memory stays bounded by count-min sketches of that total
+// size plus a fixed number of heavy-hitter candidates per thread
+bool ingestCorpus(const string &corpusFile, const string &outputFile, size_t sketchMegabytes)
+{
+    // Map the corpus
+    MappedFile corpus;
+    if (!mapFile(corpus, corpusFile))
+    {
+        cout << "Could not read " << corpusFile << ".\n";
+        return false;
+    }
+    auto started = chrono::steady_clock::now();
+    const char *data = reinterpret_cast<const char *>(corpus.data);
+    size_t size = corpus.size;
+
+    // Split at non-letters so no word spans two threads
+    size_t threadCount = max(1u, thread::hardware_concurrency());
+    vector<size_t> bounds(threadCount + 1, size);
+    for (size_t t = 0; t < threadCount; t++)
+    {
+        size_t bound = size / threadCount * t;
+        while (bound > 0 && bound < size && static_cast<uint8_t>((data[bound - 1] | 0x20) - 'a') < 26)
+        {
+            bound++;
+        }
+        bounds[t] = max(bound, t > 0 ? bounds[t - 1] : 0);
+    }
+
+    // Each thread gets its own sketch in bounded mode
+    vector<IngestShard> shards(ingestShards);
+    vector<IngestWorker> workers(threadCount);
+    size_t width = 1;
+    while (sketchMegabytes > 0 && width * 2 * ingestSketchDepth * sizeof(uint32_t) * threadCount <= sketchMegabytes << 20)
+    {
+        width *= 2;
+    }
+    for (IngestWorker &worker : workers)
+    {
+        clearIngestTable(worker);
+        if (sketchMegabytes > 0)
+        {
+            worker.sketch.width = width;
+            worker.sketch.cells.assign(width * ingestSketchDepth, 0);
+        }
+    }
+
+    // Tokenize and count in parallel
+    vector<thread> threads;
+    for (size_t t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([&, t]()
+                             {
+            IngestWorker &worker = workers[t];
+            ingestRange(worker, shards, data, bounds[t], bounds[t + 1]);
+            if (worker.sketch.cells.empty())
+            {
+                flushIngestTable(worker, shards);
+            } });
+    }
+    for (thread &worker : threads)
+    {
+        worker.join();
+    }
+    unmapFile(corpus);
+
+    // Gather the counts; bounded mode sums the sketches and re-estimates
+    // every thread's candidates against the total
+    vector<pair<uint64_t, string>> ranked;
+    uint64_t tokens = 0;
+    for (const IngestWorker &worker : workers)
+    {
+        tokens += worker.tokens;
+    }
+    if (sketchMegabytes > 0)
+    {
+        CountMinSketch &total = workers[0].sketch;
+        for (size_t t = 1; t < threadCount; t++)
+        {
+            for (size_t i = 0; i < total.cells.size(); i++)
+            {
+                uint64_t sum = static_cast<uint64_t>(total.cells[i]) + workers[t].sketch.cells[i];
+                total.cells[i] = static_cast<uint32_t>(min<uint64_t>(sum, numeric_limits<uint32_t>::max()));
+            }
+        }
+        unordered_set<string> seen;
+        for (const IngestWorker &worker : workers)
+        {
+            for (const IngestSlot &slot : worker.slots)
+            {
+                string word = worker.letters.substr(slot.offset, slot.length);
+                if (slot.length != 0 && seen.insert(word).second)
+                {
+                    ranked.push_back(make_pair(sketchEstimate(total, slot.hash), word));
+                }
+            }
+        }
+    }
+    else
+    {
+        for (IngestShard &shard : shards)
+        {
+            for (const auto &entry : shard.counts)
+            {
+                ranked.push_back(make_pair(entry.second, entry.first));
+            }
+        }
+    }
+    size_t distinct = ranked.size();
+
+    // Most frequent first, ties alphabetical, rare words dropped
+    ranked.erase(remove_if(ranked.begin(), ranked.end(), [](const pair<uint64_t, string> &entry)
+                           { return entry.first < ingestMinCount; }),
+                 ranked.end());
+    sort(ranked.begin(), ranked.end(), [](const pair<uint64_t, string> &a, const pair<uint64_t, string> &b)
+         { return a.first != b.first ? a.first > b.first : a.second < b.second; });
+    if (ranked.size() > maxWords)
+    {
+        ranked.resize(maxWords);
+    }
+
+    // One word per line, in rank order
+    ofstream out(outputFile, ios::binary);
+    for (const auto &entry : ranked)
+    {
+        out << entry.second << '\n';
+    }
+    if (!out)
+    {
+        cout << "Could not write " << outputFile << ".\n";
+        return false;
+    }
+
+    // Precompute the difficulty tiers alongside
+    vector<string> text;
+    vector<uint64_t> counts;
+    for (const auto &entry : ranked)
+    {
+        text.push_back(entry.second);
+        counts.push_back(entry.first);
+    }
+    array<double, 4> weights = {tierWeightFrequency, tierWeightLength, tierWeightRarity, tierWeightAmbiguity};
+    compileFrequencyTable(text, counts, weights, frequencyFileFor(outputFile));
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+    cout << "Read " << size / 1000000.0 << " MB in " << seconds << " s (" << size / 1000000.0 / max(seconds, 1e-9) << " MB/s): "
+         << tokens << " tokens, " << distinct << (sketchMegabytes > 0 ? " candidate" : " distinct") << " words.\n";
+    cout << "Wrote " << ranked.size() << " words by frequency to " << outputFile << " and tiers to " << frequencyFileFor(outputFile) << ".\n";
+    return true;
+}
+
+// Function to name the frequency table that goes with a dictionary
+// "words.txt" -> "words.freq"
+string frequencyFileFor(const string &dictionaryFile)
+{
+    size_t dot = dictionaryFile.find_last_of('.');
+    size_t slash = dictionaryFile.find_last_of("/\\");
+    if (dot == string::npos || (slash != string::npos && dot < slash))
+    {
+        return dictionaryFile + ".freq";
+    }
+    return dictionaryFile.substr(0, dot) + ".freq";
+}
+
+// Function to hash the first count words of a list
+// Words appended later leave the hash unchanged
+uint64_t wordListFingerprint(const vector<string> &text, size_t count)
+{
+    uint64_t fingerprint = count;
+    for (size_t i = 0; i < count && i < text.size(); i++)
+    {
+        fingerprint = mixHash(fingerprint ^ hashWord(text[i]), i);
+    }
+    return fingerprint;
+}
+
+// Function to hash the first count words of a store
+// Words appended later leave the hash unchanged
+uint64_t wordListFingerprint(const WordStore &words, size_t count)
+{
+    uint64_t fingerprint = count;
+    for (size_t i = 0; i < count && i < wordStoreSize(words); i++)
+    {
+        fingerprint = mixHash(fingerprint ^ hashWord(wordAt(words, static_cast<uint32_t>(i))), i);
+    }
+    return fingerprint;
+}
+
+// Function to rank values from 0 to 1
+// Each rank is the share of values strictly below, so ties share a rank
+void percentiles(const vector<double> &values, vector<double> &ranks)
+{
+    vector<uint32_t> order(values.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        order[i] = static_cast<uint32_t>(i);
+    }
+    sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+         { return values[a] < values[b]; });
+    ranks.resize(values.size());
+    size_t below = 0;
+    for (size_t k = 0; k < order.size(); k++)
+    {
+        if (k > 0 && values[order[k]] != values[order[k - 1]])
+        {
+            below = k;
+        }
+        ranks[order[k]] = static_cast<double>(below) / static_cast<double>(order.size());
+    }
+}
+
+// Function to precompute every word's difficulty and write the table
+// Four measures are ranked from 0 (easiest) to 1 and mixed by weight:
+// rarity in the corpus, length, how uncommon the letters are, and how
+// few other words share the letters (any anagram is accepted, so a word
+// with many is easier). Words are then given the dictionary's own
+// lengths in order of that score, so the tiers keep their sizes but a
+// short rare word like "rhythm" plays longer than "computer"
+bool compileFrequencyTable(const vector<string> &text, const vector<uint64_t> &counts, const array<double, 4> &weights, const string &filename)
+{
+    size_t wordCount = text.size();
+    array<vector<double>, 4> measures;
+    for (vector<double> &measure : measures)
+    {
+        measure.resize(wordCount);
+    }
+
+    // Letter shares over the whole list, and anagram class sizes
+    array<double, 26> letterCounts = {};
+    double letterTotal = 0;
+    unordered_map<uint64_t, uint32_t> classSizes;
+    for (const string &word : text)
+    {
+        for (char c : word)
+        {
+            unsigned letter = static_cast<unsigned>(c - 'a');
+            if (letter < 26)
+            {
+                letterCounts[letter]++;
+                letterTotal++;
+            }
+        }
+        string sorted = word;
+        sort(sorted.begin(), sorted.end());
+        classSizes[hashWord(sorted)]++;
+    }
+
+    // Raw measures, larger is harder
+    for (size_t i = 0; i < wordCount; i++)
+    {
+        const string &word = text[i];
+        double surprise = 0;
+        for (char c : word)
+        {
+            unsigned letter = static_cast<unsigned>(c - 'a');
+            surprise += letter < 26 ? -log2(letterCounts[letter] / letterTotal) : 8.0;
+        }
+        string sorted = word;
+        sort(sorted.begin(), sorted.end());
+        measures[0][i] = -static_cast<double>(i < counts.size() ? counts[i] : 0);
+        measures[1][i] = static_cast<double>(word.length());
+        measures[2][i] = word.empty() ? 0 : surprise / static_cast<double>(word.length());
+        measures[3][i] = -static_cast<double>(classSizes[hashWord(sorted)]);
+    }
+
+    // Mix the ranked measures
+    vector<double> score(wordCount, 0.0);
+    double weightTotal = max(1e-9, weights[0] + weights[1] + weights[2] + weights[3]);
+    vector<double> ranks;
+    for (size_t m = 0; m < measures.size(); m++)
+    {
+        percentiles(measures[m], ranks);
+        for (size_t i = 0; i < wordCount; i++)
+        {
+            score[i] += weights[m] / weightTotal * ranks[i];
+        }
+    }
+
+    // Hand out the dictionary's lengths in score order
+    vector<uint32_t> byScore(wordCount);
+    vector<uint8_t> lengths(wordCount);
+    for (size_t i = 0; i < wordCount; i++)
+    {
+        byScore[i] = static_cast<uint32_t>(i);
+        lengths[i] = static_cast<uint8_t>(min<size_t>(text[i].length(), 255));
+    }
+    stable_sort(byScore.begin(), byScore.end(), [&](uint32_t a, uint32_t b)
+                { return score[a] < score[b]; });
+    sort(lengths.begin(), lengths.end());
+    vector<FrequencyEntry> entries(wordCount);
+    for (size_t k = 0; k < wordCount; k++)
+    {
+        FrequencyEntry &entry = entries[byScore[k]];
+        entry.count = static_cast<uint32_t>(min<uint64_t>(byScore[k] < counts.size() ? counts[byScore[k]] : 0, numeric_limits<uint32_t>::max()));
+        entry.ratedLength = lengths[k];
+        entry.tier = static_cast<uint8_t>(isEasyWord(lengths[k]) ? 1 : isMediumWord(lengths[k]) ? 2 : isHardWord(lengths[k]) ? 3 : 0);
+    }
+
+    // Header, then one entry per word ID
+    FrequencyHeader header = {frequencyMagic, static_cast<uint32_t>(wordCount), wordListFingerprint(text, wordCount),
+                              {static_cast<float>(weights[0]), static_cast<float>(weights[1]), static_cast<float>(weights[2]), static_cast<float>(weights[3])}};
+    ofstream out(filename, ios::binary);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(entries.data()), static_cast<streamsize>(entries.size() * sizeof(FrequencyEntry)));
+    return static_cast<bool>(out);
+}
+
+// Function to map a frequency table if it was built for these words
+// The table may cover fewer words than are loaded (words added from
+// the shop); those words simply have no entry
+void loadFrequencyTable(DictionaryIndex &index, const vector<string> &text, const string &filename)
+{
+    index.frequencyCount = 0;
+    if (!mapFile(index.frequencies, filename))
+    {
+        unmapFile(index.frequencies);
+        return;
+    }
+    useFrequencyTable(index, text);
+}
+
+// Function to keep the table in index.frequencies if it was built for
+// these words, mapped from a file or compiled into the program, and
+// to release it otherwise
+void useFrequencyTable(DictionaryIndex &index, const vector<string> &text)
+{
+    index.frequencyCount = 0;
+    MappedFile &file = index.frequencies;
+    FrequencyHeader header = {};
+    if (file.size < sizeof(header))
+    {
+        unmapFile(file);
+        return;
+    }
+    memcpy(&header, file.data, sizeof(header));
+    if (header.magic != frequencyMagic || file.size != sizeof(header) + header.wordCount * sizeof(FrequencyEntry) ||
+        header.wordCount > text.size() || header.fingerprint != wordListFingerprint(text, header.wordCount))
+    {
+        unmapFile(file);
+        return;
+    }
+    index.frequencyCount = header.wordCount;
+}
+
+// Function to get a word's entry in the frequency table, if it has one
+const FrequencyEntry *frequencyEntry(uint32_t wordId)
+{
+    if (wordId >= dictionaryIndex.frequencyCount)
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<const FrequencyEntry *>(dictionaryIndex.frequencies.data + sizeof(FrequencyHeader)) + wordId;
+}
+
+// Function to rebuild a dictionary's tiers with another mix
+// Counts come from the existing frequency table when it matches
+bool compileTiers(const string &dictionaryFile, const array<double, 4> &weights)
+{
+    // Read the words as the loader would
+    ifstream in(dictionaryFile);
+    vector<string> text;
+    string word;
+    while (text.size() < maxWords && in >> word)
+    {
+        text.push_back(word);
+    }
+    if (text.empty())
+    {
+        cout << "No words in " << dictionaryFile << ".\n";
+        return false;
+    }
+
+    // Counts from the old table; none if it is missing
+    string filename = frequencyFileFor(dictionaryFile);
+    loadFrequencyTable(dictionaryIndex, text, filename);
+    vector<uint64_t> counts(text.size(), 0);
+    for (size_t i = 0; i < dictionaryIndex.frequencyCount; i++)
+    {
+        counts[i] = frequencyEntry(static_cast<uint32_t>(i))->count;
+    }
+    unmapFile(dictionaryIndex.frequencies);
+    dictionaryIndex.frequencyCount = 0;
+    if (!compileFrequencyTable(text, counts, weights, filename))
+    {
+        cout << "Could not write " << filename << ".\n";
+        return false;
+    }
+
+    // Report the tier sizes
+    MappedFile table;
+    array<size_t, 4> tierSizes = {};
+    if (mapFile(table, filename))
+    {
+        const FrequencyEntry *entries = reinterpret_cast<const FrequencyEntry *>(table.data + sizeof(FrequencyHeader));
+        for (size_t i = 0; i < text.size(); i++)
+        {
+            tierSizes[entries[i].tier]++;
+        }
+    }
+    unmapFile(table);
+    cout << "Wrote tiers for " << text.size() << " words to " << filename << ": " << tierSizes[1] << " easy, "
+         << tierSizes[2] << " medium, " << tierSizes[3] << " hard.\n";
+    return true;
+}
+
+#ifdef UNSCRAMBLE_X86_SIMD
+// AVX2 kernel: flag the bytes of 64 equal to a value
+__attribute__((target("avx2"))) uint64_t byteBitmapAvx2(const char *block, char value)
+{
+    __m256i want = _mm256_set1_epi8(value);
+    __m256i low = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(block)), want);
+    __m256i high = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32)), want);
+    return static_cast<uint32_t>(_mm256_movemask_epi8(low)) | static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(high))) << 32;
+}
+#endif
+
+// Function to flag the bytes of 64 equal to a value, one bit per byte
+uint64_t byteBitmap(const char *block, char value)
+{
+#ifdef UNSCRAMBLE_X86_SIMD
+    // Vector kernel when the CPU has it
+    if (cpuHasAvx2())
+    {
+        return byteBitmapAvx2(block, value);
+    }
+#endif
+
+    // Scalar fallback
+    uint64_t bitmap = 0;
+    for (size_t i = 0; i < 64; i++)
+    {
+        bitmap |= static_cast<uint64_t>(block[i] == value) << i;
+    }
+    return bitmap;
+}
+
+// Function to count a lint problem and describe the first few
+void noteLintProblem(LintReport &report, uint64_t &counter, uint64_t line, const function<string()> &describe)
+{
+    // Descriptions are only built while there is room for them
+    counter++;
+    if (report.examples.size() < lintExamples)
+    {
+        report.examples.push_back("line " + to_string(line) + ": " + describe());
+    }
+}
+
+// Function to find a lowercase hash in a lint report's table
+// Returns its slot, or the empty slot where it would go. The table is
+// open-addressed and kept at most half full
+size_t lintSlot(const LintReport &report, uint64_t lower)
+{
+    size_t mask = report.slots.size() - 1;
+    size_t slot = lower & mask;
+    while (report.slots[slot].second != 0 && report.slots[slot].first != lower)
+    {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+// Function to add a word's hashes to a lint report's table and filter
+void lintInsert(LintReport &report, uint64_t lower, uint64_t spelling)
+{
+    report.slots[lintSlot(report, lower)] = make_pair(lower, spelling);
+    size_t bit = (lower >> 32) & (report.filter.size() * 64 - 1);
+    report.filter[bit / 64] |= 1ULL << (bit % 64);
+}
+
+// Function to check if a lowercase word was seen by a lint
+// The filter turns most unknown words away without touching the table
+bool lintKnows(const LintReport &report, const string &lower)
+{
+    if (report.slots.empty())
+    {
+        return false;
+    }
+    uint64_t hash = hashWord(lower);
+    size_t bit = (hash >> 32) & (report.filter.size() * 64 - 1);
+    return (report.filter[bit / 64] & (1ULL << (bit % 64))) != 0 && report.slots[lintSlot(report, hash)].second != 0;
+}
+
+// Function to check one word against the words seen before it
+// Returns true if the word is clean and new, so a normalized copy
+// should keep it
+bool lintWord(LintReport &report, const char *word, size_t length, bool alphabetic, uint64_t line)
+{
+    report.lines++;
+    string text(word, length);
+    if (!alphabetic)
+    {
+        noteLintProblem(report, report.nonAlphabetic, line, [&]()
+                        { return "\"" + text + "\" is not just letters"; });
+        return false;
+    }
+    if (length > lintMaxLength)
+    {
+        noteLintProblem(report, report.overLong, line, [&]()
+                        { return "\"" + text.substr(0, lintMaxLength) + "...\" is over " + to_string(lintMaxLength) + " letters"; });
+        return false;
+    }
+
+    // The lowercase hash is only computed when there are capitals
+    uint64_t spelling = hashWord(text);
+    uint64_t lower = spelling;
+    if (any_of(text.begin(), text.end(), [](char c)
+               { return c >= 'A' && c <= 'Z'; }))
+    {
+        for (char &c : text)
+        {
+            c |= 0x20;
+        }
+        lower = hashWord(text);
+    }
+    // Grow the table at half full
+    if (2 * (report.used + 1) > report.slots.size())
+    {
+        LintReport grown;
+        grown.slots.assign(max<size_t>(1024, 2 * report.slots.size()), make_pair(0, 0));
+        grown.filter.assign(grown.slots.size() / 16, 0);
+        for (const auto &entry : report.slots)
+        {
+            if (entry.second != 0)
+            {
+                lintInsert(grown, entry.first, entry.second);
+            }
+        }
+        report.slots.swap(grown.slots);
+        report.filter.swap(grown.filter);
+    }
+
+    // New words take a slot; spellings are never 0 so 0 marks empty
+    spelling |= spelling == 0;
+    uint64_t seen = report.slots[lintSlot(report, lower)].second;
+    if (seen == 0)
+    {
+        lintInsert(report, lower, spelling);
+        report.used++;
+        return true;
+    }
+    if (seen == spelling)
+    {
+        noteLintProblem(report, report.duplicates, line, [&]()
+                        { return "\"" + string(word, length) + "\" is a duplicate"; });
+    }
+    else
+    {
+        noteLintProblem(report, report.caseCollisions, line, [&]()
+                        { return "\"" + string(word, length) + "\" differs from an earlier word only in case"; });
+    }
+    return false;
+}
+
+// Function to check if a lowercase word splits into two known words,
+// as "guava" and "marshmellow" glued by a missing newline
+void lintConcatenation(LintReport &report, const string &word, uint64_t line)
+{
+    string part;
+    for (size_t split = lintMinPart; split + lintMinPart <= word.length(); split++)
+    {
+        part.assign(word, 0, split);
+        if (!lintKnows(report, part))
+        {
+            continue;
+        }
+        part.assign(word, split, string::npos);
+        if (lintKnows(report, part))
+        {
+            noteLintProblem(report, report.concatenated, line, [&]()
+                            { return "\"" + word + "\" may be \"" + word.substr(0, split) + "\" and \"" + word.substr(split) + "\" glued together"; });
+            return;
+        }
+    }
+}
+
+// Function to stream a file and visit each non-empty line
+// Lines are found and checked for non-letters 64 bytes at a time from
+// newline and letter bitmaps; the visitor gets the line without its
+// '\r', whether it is all letters, and its 1-based number. A line too
+// long for the buffer is reported and skipped
+bool streamLines(const string &filename, LintReport &report, const function<void(const char *, size_t, bool, uint64_t)> &visit)
+{
+    ifstream in(filename, ios::binary);
+    if (!in)
+    {
+        return false;
+    }
+    vector<char> buffer(lintBufferBytes + 64);
+    vector<uint64_t> newlines((lintBufferBytes + 63) / 64);
+    vector<uint64_t> others((lintBufferBytes + 63) / 64);
+    size_t filled = 0;
+    uint64_t line = 0;
+    bool skipping = false;
+    char last = '\n';
+    report.bytes = 0;
+    while (true)
+    {
+        // Refill behind any partial line kept from the last read
+        in.read(buffer.data() + filled, static_cast<streamsize>(lintBufferBytes - filled));
+        size_t got = static_cast<size_t>(in.gcount());
+        bool finished = got < lintBufferBytes - filled;
+        size_t size = filled + got;
+        report.bytes += got;
+        if (got > 0)
+        {
+            last = buffer[size - 1];
+        }
+
+        // Newlines, and bytes that are neither letters nor newlines
+        memset(buffer.data() + size, '\n', 64);
+        size_t blocks = (size + 63) / 64;
+        for (size_t b = 0; b < blocks; b++)
+        {
+            const char *block = buffer.data() + b * 64;
+            newlines[b] = byteBitmap(block, '\n');
+            others[b] = ~(letterBitmap(block) | newlines[b]);
+        }
+
+        // Visit each complete line
+        size_t start = 0;
+        auto finishLine = [&](size_t end)
+        {
+            line++;
+            size_t stop = end;
+            while (stop > start && buffer[stop - 1] == '\r')
+            {
+                stop--;
+            }
+            bool alphabetic = true;
+            for (size_t b = start / 64; b * 64 < stop && alphabetic; b++)
+            {
+                uint64_t mask = ~0ULL;
+                if (b == start / 64)
+                {
+                    mask &= ~0ULL << (start % 64);
+                }
+                if (b == (stop - 1) / 64 && stop % 64 != 0)
+                {
+                    mask &= (1ULL << (stop % 64)) - 1;
+                }
+                alphabetic = (others[b] & mask) == 0;
+            }
+            if (!skipping && stop > start)
+            {
+                visit(buffer.data() + start, stop - start, alphabetic, line);
+            }
+            skipping = false;
+            start = end + 1;
+        };
+        for (size_t b = 0; b < blocks; b++)
+        {
+            for (uint64_t bits = newlines[b]; bits != 0; bits &= bits - 1)
+            {
+                size_t end = b * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+                if (end >= size)
+                {
+                    break;
+                }
+                finishLine(end);
+            }
+        }
+
+        // Keep the partial line, or give up on one filling the buffer
+        if (finished)
+        {
+            if (start < size)
+            {
+                finishLine(size);
+            }
+            break;
+        }
+        if (start == 0 && size == lintBufferBytes)
+        {
+            if (!skipping)
+            {
+                noteLintProblem(report, report.overLong, line + 1, [&]()
+                                { return "line is over " + to_string(lintBufferBytes) + " bytes"; });
+            }
+            skipping = true;
+            filled = 0;
+            continue;
+        }
+        memmove(buffer.data(), buffer.data() + start, size - start);
+        filled = size - start;
+    }
+    report.missingNewline = report.bytes > 0 && last != '\n';
+    return true;
+}
+
+// Function to show the results of a lint
+void printLintReport(const LintReport &report)
+{
+    cout << "  duplicates:            " << report.duplicates << "\n";
+    cout << "  not just letters:      " << report.nonAlphabetic << "\n";
+    cout << "  differ only in case:   " << report.caseCollisions << "\n";
+    cout << "  over " << lintMaxLength << " letters:       " << report.overLong << "\n";
+    cout << "  possibly glued words:  " << report.concatenated << "\n";
+    if (report.missingNewline)
+    {
+        cout << "  the last line has no newline; files appended after it will glue onto its word\n";
+    }
+    for (const string &example : report.examples)
+    {
+        cout << "  " << example << "\n";
+    }
+}
+
+// Function to validate a dictionary file and optionally write a
+// normalized copy: lowercase, letters only, no duplicates, one word per
+// line with a final newline. A second pass looks for glued words once
+// every word is known
+bool lintDictionary(const string &filename, const string &outputFile)
+{
+    auto started = chrono::steady_clock::now();
+    LintReport report;
+    ofstream out;
+    if (!outputFile.empty())
+    {
+        out.open(outputFile, ios::binary);
+    }
+
+    // Check every line, keeping the clean ones
+    string word;
+    bool readable = streamLines(filename, report, [&](const char *text, size_t length, bool alphabetic, uint64_t line)
+                                {
+        if (lintWord(report, text, length, alphabetic, line) && out.is_open())
+        {
+            word.assign(text, length);
+            for (char &c : word)
+            {
+                c |= 0x20;
+            }
+            out << word << '\n';
+        } });
+    if (!readable)
+    {
+        cout << "Could not read " << filename << ".\n";
+        return false;
+    }
+
+    // Look for glued pairs among the clean words
+    LintReport pass;
+    streamLines(filename, pass, [&](const char *text, size_t length, bool alphabetic, uint64_t line)
+                {
+        if (alphabetic && length >= 2 * lintMinPart && length <= lintMaxLength)
+        {
+            word.assign(text, length);
+            for (char &c : word)
+            {
+                c |= 0x20;
+            }
+            lintConcatenation(report, word, line);
+        } });
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+    cout << "Checked " << report.lines << " lines (" << report.bytes / 1000000.0 << " MB) of " << filename << " in " << seconds << " s ("
+         << 2 * report.bytes / 1000000.0 / max(seconds, 1e-9) << " MB/s over two passes).\n";
+    printLintReport(report);
+    if (out.is_open())
+    {
+        cout << (out ? "Wrote the clean words to " : "Could not write ") << outputFile << ".\n";
+    }
+    return true;
+}
+
+// Function to put the word IDs in length order
+// A counting sort on the stored lengths, so it is cheap enough to redo
+// whenever words are added
+void buildLengthOrder(DictionaryIndex &index, const WordStore &words)
+{
+    size_t wordCount = words.lengths.size();
+    index.lengthStarts.assign(257, 0);
+    for (uint8_t length : words.lengths)
+    {
+        index.lengthStarts[length + 1]++;
+    }
+    for (size_t length = 1; length < index.lengthStarts.size(); length++)
+    {
+        index.lengthStarts[length] += index.lengthStarts[length - 1];
+    }
+    index.byLength.resize(wordCount);
+    index.lengthRank.resize(wordCount);
+    vector<uint32_t> next(index.lengthStarts.begin(), index.lengthStarts.end() - 1);
+    for (size_t i = 0; i < wordCount; i++)
+    {
+        uint32_t rank = next[words.lengths[i]]++;
+        index.byLength[rank] = static_cast<uint32_t>(i);
+        index.lengthRank[i] = rank;
+    }
+}
+
+// Function to build the indexes only the game modes use
+// Needs the letter masks of every word first
+void buildModeIndexes(DictionaryIndex &index, const vector<string> &text)
+{
+    // Wildcard buckets for word ladders
+    buildLadderIndex(index.ladder, text);
+
+    // Trie for the letter grid solver
+    buildGridTrie(index.gridTrie, text);
+
+    // Spelling bee groups
+    buildBeeIndex(index.bee, index.letterMasks, text);
+
+    // Flat word buckets for evil hangman
+    buildHangmanIndex(index.hangman, index.letterMasks, text);
+
+    // Positional bitsets for crossword patterns
+    buildPatternIndex(index.patterns, index.letterMasks, text);
+
+    // Wordle tables are rebuilt for the new words on first use
+    for (WordleTable &table : index.wordle)
+    {
+        unmapFile(table.cache);
+        table = WordleTable();
+    }
+    index.modesStale = false;
+}
+
+// Function to rebuild the game mode indexes after packs were merged
+// Buying a pack skips this, so the cost is paid once, by the first
+// game mode played afterwards
+void refreshModeIndexes()
+{
+    if (!dictionaryIndex.modesStale)
+    {
+        return;
+    }
+    const WordStore &words = *dictionaryIndex.words;
+    if (words.backend == WordBackend::Strings)
+    {
+        buildModeIndexes(dictionaryIndex, words.strings);
+        return;
+    }
+    vector<string> expanded;
+    expanded.reserve(wordStoreSize(words));
+    for (size_t i = 0; i < wordStoreSize(words); i++)
+    {
+        expanded.push_back(wordAt(words, static_cast<uint32_t>(i)));
+    }
+    buildModeIndexes(dictionaryIndex, expanded);
+}
+
+// Function to add words just appended to the store to the indexes
+// The guess path (bloom filter, word IDs, histograms, letter sets,
+// length order and ratings) is updated in place, touching only the new
+// words, apart from the cheap length sort. The game mode indexes are
+// flat arrays that would have to be rebuilt, so they are marked stale
+void mergeDictionaryIndex(const WordStore &words, const vector<string> &newWords)
+{
+    size_t wordCount = wordStoreSize(words);
+    size_t firstId = wordCount - newWords.size();
+
+    // Add to the bloom filter, regrowing it with headroom when the new
+    // words would push its false positive rate past the target
+    if (wordCount > dictionaryIndex.bloom.capacity)
+    {
+        buildBloomFilter(dictionaryIndex.bloom, wordCount * packBloomHeadroom, bloomFalsePositiveRate);
+        for (size_t i = 0; i < firstId; i++)
+        {
+            bloomInsert(dictionaryIndex.bloom, words.backend == WordBackend::Strings ? words.strings[i] : wordAt(words, static_cast<uint32_t>(i)));
+        }
+    }
+    for (const string &word : newWords)
+    {
+        bloomInsert(dictionaryIndex.bloom, word);
+    }
+
+    // The perfect hash can't take new keys; a side table holds them
+    // until the next full build (the trie backend already has them)
+    if (words.backend == WordBackend::Strings)
+    {
+        dictionaryIndex.overflowIds.reserve(dictionaryIndex.overflowIds.size() + newWords.size());
+        for (size_t i = 0; i < newWords.size(); i++)
+        {
+            dictionaryIndex.overflowIds.emplace(newWords[i], static_cast<uint32_t>(firstId + i));
+        }
+    }
+
+    // Histograms and letter sets of the new words
+    dictionaryIndex.histograms.resize(wordCount);
+    computeHistograms(newWords, dictionaryIndex.histograms.data() + firstId);
+    dictionaryIndex.letterMasks.resize(wordCount);
+    for (size_t i = 0; i < newWords.size(); i++)
+    {
+        dictionaryIndex.letterMasks[firstId + i] = letterMaskOf(newWords[i]);
+    }
+
+    // Length order, starting ratings, and stale mode indexes
+    buildLengthOrder(dictionaryIndex, words);
+    syncWordRatings(words);
+    dictionaryIndex.modesStale = true;
+}
+
+// Function to load a word pack from a text file, once
+// Returns the number of words added
+size_t loadPack(const string &filename, WordStore &words)
+{
+    // Read the pack, linting it on its own; its words being in the
+    // dictionary already is expected, not a problem
+    LintReport lint;
+    vector<string> packWords;
+    if (!readLintedWords(filename, lint, maxWords, packWords))
+    {
+        cout << "Could not read " << filename << ".\n";
+        return 0;
+    }
+    if (packWords.empty())
+    {
+        cout << filename << " has no words.\n";
+        return 0;
+    }
+
+    // Turn the pack away if it was bought before, else merge its
+    // distinct words
+    vector<uint32_t> distinct;
+    uint64_t contentHash = distinctPackWords(packWords, distinct);
+    if (ownsPack(contentHash))
+    {
+        cout << "You already own the words in " << filename << ".\n";
+        return 0;
+    }
+    size_t added = mergePack(filename, contentHash, packWords, distinct, words);
+    cout << added << " new words added!\n";
+    return added;
+}
+
+// Function to find the distinct words of a pack and hash them
+// Repeats are dropped with an open-addressed set of indexes into
+// packWords, compared by spelling. The hash sums the mixed hashes of
+// the distinct words, so their order does not matter
+uint64_t distinctPackWords(const vector<string> &packWords, vector<uint32_t> &distinct)
+{
+    size_t tableSize = 16;
+    while (tableSize < 2 * packWords.size())
+    {
+        tableSize *= 2;
+    }
+    vector<uint32_t> table(tableSize, noWordId);
+    distinct.clear();
+    uint64_t contentHash = 0;
+    for (size_t i = 0; i < packWords.size(); i++)
+    {
+        uint64_t hash = hashWord(packWords[i]);
+        size_t slot = hash & (tableSize - 1);
+        while (table[slot] != noWordId && packWords[table[slot]] != packWords[i])
+        {
+            slot = (slot + 1) & (tableSize - 1);
+        }
+        if (table[slot] == noWordId)
+        {
+            table[slot] = static_cast<uint32_t>(i);
+            distinct.push_back(static_cast<uint32_t>(i));
+            contentHash += mixHash(hash, 0);
+        }
+    }
+    return contentHash;
+}
+
+// Function to check if a pack with these words was merged before,
+// whatever their order
+bool ownsPack(uint64_t contentHash)
 {
-    // Display the difficulty menu
-    displayDifficultyMenu();
+    return any_of(loadedPacks.begin(), loadedPacks.end(), [&](const WordPack &pack)
+                  { return pack.contentHash == contentHash; });
+}
 
-    // Variable to store difficulty choice
-    int difficulty;
+// Function to add a pack's distinct words to the store, once
+// Only words not already in the store are added, up to maxWords, and
+// merged into the indexes without a rebuild. Callers tell the player
+// about packs they own already; one slipping through adds nothing.
+// Returns the number of words added
+size_t mergePack(const string &name, uint64_t contentHash, vector<string> &packWords, const vector<uint32_t> &distinct, WordStore &words)
+{
+    // Never merge the same pack twice
+    if (ownsPack(contentHash))
+    {
+        return 0;
+    }
 
-    // Get difficulty choice from user
-    // This can be easy, medium, and hard
-    cin >> difficulty;
+    // Words the store has already are not added again
+    vector<string> newWords;
+    for (uint32_t i : distinct)
+    {
+        if (!isDictionaryWord(packWords[i]))
+        {
+            newWords.push_back(move(packWords[i]));
+        }
+    }
 
-    // Return chosen difficulty
-    return difficulty;
-}
+    // Stop at the store's capacity
+    size_t room = maxWords - min(maxWords, wordStoreSize(words));
+    if (newWords.size() > room)
+    {
+        cout << "The word store is full; only " << room << " of " << newWords.size() << " new words fit.\n";
+        newWords.resize(room);
+    }
 
-// Helper function to check if a word is an "Easy" word
-bool isEasyWord(const string &word)
-{
-    // Check if word length falls within easy range
-    return word.length() >= easyMinLength && word.length() <= easyMaxLength;
+    // Add the words to the store, which may reorder them, then record
+    // the pack and index the words in their new order
+    WordPack pack;
+    pack.filename = name;
+    pack.contentHash = contentHash;
+    pack.firstId = static_cast<uint32_t>(wordStoreSize(words));
+    appendWords(words, newWords);
+    pack.wordCount = static_cast<uint32_t>(newWords.size());
+    loadedPacks.push_back(pack);
+    mergeDictionaryIndex(words, newWords);
+    return newWords.size();
 }
 
-// Helper function to check if a word is a "Medium" word
-bool isMediumWord(const string &word)
+// Function to get the cache file of a pack from its content hash
+string packPath(uint64_t contentHash)
 {
-    // Check if word length falls within medium range
-    return word.length() >= mediumMinLength && word.length() <= mediumMaxLength;
+    char name[17];
+    snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(contentHash));
+    return string(packCacheDir) + "/" + name + ".pack";
 }
 
-// Helper function to check if a word is a "Hard" word
-bool isHardWord(const string &word)
+// Function to write a pack's distinct words to the cache
+// The same words always land in the same file, so writing a pack twice
+// just rewrites identical bytes
+bool writePackFile(const vector<string> &packWords, const vector<uint32_t> &distinct, uint64_t contentHash)
 {
-    // Check if word length is within hard range
-    return word.length() >= hardMinLength;
+    // Letter offsets, then the letters
+    vector<uint32_t> offsets(1, 0);
+    string letters;
+    for (uint32_t i : distinct)
+    {
+        letters += packWords[i];
+        offsets.push_back(static_cast<uint32_t>(letters.size()));
+    }
+    PackHeader header = {packMagic, static_cast<uint32_t>(distinct.size()), contentHash, letters.size()};
+
+#ifdef UNSCRAMBLE_POSIX_MMAP
+    // Make the cache directory if it is not there yet
+    mkdir(packCacheDir, 0755);
+#endif
+    ofstream out(packPath(contentHash), ios::binary);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(offsets.data()), static_cast<streamsize>(offsets.size() * sizeof(uint32_t)));
+    out.write(letters.data(), static_cast<streamsize>(letters.size()));
+    return static_cast<bool>(out);
 }
 
-// Function to filter words by selected difficulty level
-void filterWordsByDifficulty(array<string, maxWords> &filteredWords, const array<string, maxWords> &words, size_t wordCount, int difficulty, size_t &filteredCount)
+// Function to map a pack from the cache and spell out its words
+// Only the pages holding the words are read, on first touch, and the
+// mapping is dropped once the words are copied out
+bool readPackFile(const CatalogPack &pack, vector<string> &packWords)
 {
-    // Initialize filtered word count
-    filteredCount = 0;
+    // Map the file and check the header against the catalog
+    MappedFile file;
+    PackHeader header = {};
+    if (mapFile(file, packPath(pack.contentHash)) && file.size >= sizeof(header))
+    {
+        memcpy(&header, file.data, sizeof(header));
+    }
+    // The letter count is checked against what is left after the
+    // offsets, so a damaged count can't wrap the size sum
+    size_t offsetBytes = (static_cast<size_t>(header.wordCount) + 1) * sizeof(uint32_t);
+    if (header.magic != packMagic || header.contentHash != pack.contentHash || header.wordCount != pack.wordCount ||
+        file.size < sizeof(header) + offsetBytes || header.letterBytes != file.size - sizeof(header) - offsetBytes)
+    {
+        unmapFile(file);
+        return false;
+    }
 
-    // Loop through each word in the word list
-    for (size_t i = 0; i < wordCount; ++i)
+    // Slice out each word, checking its offsets stay in bounds
+    const uint8_t *offsets = file.data + sizeof(header);
+    const char *letters = reinterpret_cast<const char *>(offsets + offsetBytes);
+    packWords.clear();
+    packWords.reserve(header.wordCount);
+    uint32_t start = 0;
+    memcpy(&start, offsets, sizeof(start));
+    for (uint32_t i = 0; i < header.wordCount; i++)
     {
-        // Check if word matches the selected difficulty level
-        if ((difficulty == 1 && isEasyWord(words[i])) ||
-            (difficulty == 2 && isMediumWord(words[i])) ||
-            (difficulty == 3 && isHardWord(words[i])))
+        uint32_t end = 0;
+        memcpy(&end, offsets + (i + 1) * sizeof(uint32_t), sizeof(end));
+        if (end < start || end > header.letterBytes)
         {
-            // Add matching word to filtered list
-            filteredWords[filteredCount++] = words[i];
+            unmapFile(file);
+            return false;
         }
+        packWords.push_back(string(letters + start, end - start));
+        start = end;
     }
+    unmapFile(file);
+    return true;
 }
 
-// Function to display hint menu
-void displayHintMenu()
+// Function to read the pack catalog
+// One line per pack: content hash (hex), word count, language, theme
+// and difficulty. Only this small file is read; no pack is opened
+// until it is bought
+void loadPackCatalog()
 {
-    cout << "\nAvailable Hints:\n";
-    cout << "1. Reveal the first letter\n";
-    cout << "2. Show word length\n";
-    cout << "3. Reveal a random letter\n";
-    cout << "Enter your choice: ";
+    packCatalog.clear();
+    ifstream in(packCatalogFile);
+    string hash;
+    CatalogPack pack;
+    while (in >> hash >> pack.wordCount >> pack.language >> pack.theme >> pack.difficulty)
+    {
+        pack.contentHash = strtoull(hash.c_str(), nullptr, 16);
+        packCatalog.push_back(pack);
+    }
+
+    // List by language, then theme, then difficulty
+    static const string difficultyOrder = "emh";
+    sort(packCatalog.begin(), packCatalog.end(), [](const CatalogPack &a, const CatalogPack &b)
+         { return make_tuple(a.language, a.theme, difficultyOrder.find(a.difficulty[0])) <
+                  make_tuple(b.language, b.theme, difficultyOrder.find(b.difficulty[0])); });
 }
 
-// Function to provide a hint to the player and update score
-void useHint(const string &word, int &hintsUsed, int &score)
+// Function to compile a word list into a cached pack and list it in
+// the catalog. Without a difficulty, the pack's median word length
+// picks one
+bool addCatalogPack(const string &wordFile, const string &language, const string &theme, string difficulty)
 {
-    // Check if maximum hints have been used
-    if (hintsUsed >= maxHintsPerWord)
+    // Read the words
+    ifstream in(wordFile);
+    vector<string> packWords;
+    string word;
+    while (packWords.size() < maxWords && in >> word)
     {
-        cout << "You have used all available hints for this word.\n";
-        return;
+        packWords.push_back(word);
+    }
+    vector<uint32_t> distinct;
+    uint64_t contentHash = distinctPackWords(packWords, distinct);
+    if (distinct.empty())
+    {
+        cout << "No words found in " << wordFile << ".\n";
+        return false;
     }
 
-    // Display the hint menu
-    displayHintMenu();
-    int hintChoice;
-    cin >> hintChoice;
+    // Difficulty from the median length when not given
+    if (difficulty.empty())
+    {
+        vector<size_t> lengths;
+        for (uint32_t i : distinct)
+        {
+            lengths.push_back(packWords[i].length());
+        }
+        nth_element(lengths.begin(), lengths.begin() + lengths.size() / 2, lengths.end());
+        size_t median = lengths[lengths.size() / 2];
+        difficulty = isEasyWord(median) ? "easy" : isMediumWord(median) ? "medium" : "hard";
+    }
+    if (difficulty != "easy" && difficulty != "medium" && difficulty != "hard")
+    {
+        cout << "Difficulty must be easy, medium or hard.\n";
+        return false;
+    }
 
-    // Process the player's hint choice
-    if (hintChoice == 1) // Reveal the first letter
+    // Store the pack under its content hash
+    if (!writePackFile(packWords, distinct, contentHash))
     {
-        cout << "First letter: " << word[0] << endl;
+        cout << "Could not write " << packPath(contentHash) << ".\n";
+        return false;
     }
-    else if (hintChoice == 2) // Show the word length
+
+    // Replace any listing of the same words, then rewrite the catalog;
+    // names are single words so the catalog stays one line per pack
+    CatalogPack pack;
+    pack.contentHash = contentHash;
+    pack.wordCount = static_cast<uint32_t>(distinct.size());
+    pack.language = language;
+    pack.theme = theme;
+    pack.difficulty = difficulty;
+    replace(pack.language.begin(), pack.language.end(), ' ', '-');
+    replace(pack.theme.begin(), pack.theme.end(), ' ', '-');
+    loadPackCatalog();
+    packCatalog.erase(remove_if(packCatalog.begin(), packCatalog.end(), [&](const CatalogPack &other)
+                                { return other.contentHash == contentHash; }),
+                      packCatalog.end());
+    packCatalog.push_back(pack);
+    ofstream out(packCatalogFile);
+    for (const CatalogPack &entry : packCatalog)
     {
-        cout << "Word length: " << word.length() << " letters.\n";
+        char hash[17];
+        snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(entry.contentHash));
+        out << hash << ' ' << entry.wordCount << ' ' << entry.language << ' ' << entry.theme << ' ' << entry.difficulty << '\n';
     }
-    else if (hintChoice == 3) // Reveal a random letter
+    if (!out)
     {
-        size_t randIndex = static_cast<size_t>(rand() % static_cast<int>(word.length()));
-        cout << "Revealed letter at position " << randIndex + 1 << ": " << word[randIndex] << endl;
+        cout << "Could not write " << packCatalogFile << ".\n";
+        return false;
     }
-    else
+    cout << "Added " << theme << " (" << language << ", " << difficulty << ", " << distinct.size() << " words) as "
+         << packPath(contentHash) << ".\n";
+    return true;
+}
+
+// Function to show the pack catalog and merge the pack the player picks
+void browsePackCatalog(WordStore &words)
+{
+    // Read the catalog the first time the shop shows it
+    if (packCatalog.empty())
     {
-        cout << "Invalid hint choice.\n";
+        loadPackCatalog();
+    }
+    if (packCatalog.empty())
+    {
+        cout << "No word packs are available. Run with --pack to add some.\n";
         return;
     }
 
-    // Increment hint usage
-    hintsUsed++;
-
-    // Deduct points
-    score -= hintCost;
+    // List the packs, marking those already owned
+    cout << "\nWord packs:\n";
+    for (size_t i = 0; i < packCatalog.size(); i++)
+    {
+        const CatalogPack &pack = packCatalog[i];
+        bool owned = ownsPack(pack.contentHash);
+        cout << setw(4) << i + 1 << ". " << pack.theme << " (" << pack.language << ", " << pack.difficulty << ", "
+             << pack.wordCount << " words)" << (owned ? " [owned]" : "") << "\n";
+    }
+    cout << "Enter a pack number (0 to go back): ";
+    size_t choice = 0;
+    if (!(cin >> choice) || choice == 0 || choice > packCatalog.size())
+    {
+        return;
+    }
 
-    // Display the current score
-    cout << "Hint cost deducted. Current score: " << score << endl;
+    // Unpack it from the cache, check the words are what the catalog
+    // named, and merge them
+    const CatalogPack &pack = packCatalog[choice - 1];
+    if (ownsPack(pack.contentHash))
+    {
+        cout << "You already own the " << pack.theme << " pack.\n";
+        return;
+    }
+    vector<string> packWords;
+    vector<uint32_t> distinct;
+    if (!readPackFile(pack, packWords) || distinctPackWords(packWords, distinct) != pack.contentHash)
+    {
+        cout << "The " << pack.theme << " pack is missing or damaged. Run with --pack to rebuild it.\n";
+        return;
+    }
+    size_t newWords = mergePack(pack.theme + " pack", pack.contentHash, packWords, distinct, words);
+    cout << newWords << " new words added!\n";
 }
 
-// Function to play the game with streak and combo points
-void playGame(int &score, int &highestScore, int &streak, int &maxStreak, array<string, maxWords> &words, size_t wordCount, int difficulty)
+// Function to build a complete dictionary from a word file into a
+// snapshot, with the new ID of each word in previous. Uses no shared
+// state, so it can run beside the game
+bool buildSnapshot(const string &filename, const WordStore &previous, DictionarySnapshot &snapshot)
 {
-    // Check if there are any loaded words to play with
-    if (wordCount == 0)
+    // Build, then map the previous words to their new IDs by spelling
+    if (!buildSnapshotWords(filename, snapshot))
     {
-        // Display error and exit function if no words are available
-        cout << "Error: No words loaded from the dictionary files.\n";
-
-        // Breaks out of this if statement
-        return;
+        return false;
     }
+    unordered_map<string, uint32_t> idsBySpelling;
+    idsBySpelling.reserve(wordStoreSize(snapshot.words));
+    for (size_t i = 0; i < wordStoreSize(snapshot.words); i++)
+    {
+        idsBySpelling.emplace(wordAt(snapshot.words, static_cast<uint32_t>(i)), static_cast<uint32_t>(i));
+    }
+    snapshot.newIds.assign(wordStoreSize(previous), noWordId);
+    for (size_t i = 0; i < snapshot.newIds.size(); i++)
+    {
+        auto found = idsBySpelling.find(wordAt(previous, static_cast<uint32_t>(i)));
+        if (found != idsBySpelling.end())
+        {
+            snapshot.newIds[i] = found->second;
+        }
+    }
+    return true;
+}
 
-    // Declare an array to store words filtered by difficulty
-    array<string, maxWords> filteredWords;
-
-    // Track the number of filtered words
-    size_t filteredCount = 0;
+// Function to build a snapshot's words and indexes from a word file
+bool buildSnapshotWords(const string &filename, DictionarySnapshot &snapshot)
+{
+    // Take the saved indexes when they match the file
+    snapshot.words.backend = wordBackend;
+    uint64_t checksum = 0;
+    bool hashed = wordBackend == WordBackend::Strings && fileChecksum(filename, checksum);
+    if (hashed && readIndexImage(indexImageFile, checksum, snapshot.index, snapshot.words))
+    {
+        return true;
+    }
 
-    // Filter the loaded words by selected difficulty level
-    filterWordsByDifficulty(filteredWords, words, wordCount, difficulty, filteredCount);
+    // Read the words as loadWords does, leaving the load lint alone
+    ifstream file(filename);
+    vector<string> newWords;
+    string word;
+    while (newWords.size() < maxWords && file >> word)
+    {
+        newWords.push_back(word);
+    }
+    if (newWords.empty())
+    {
+        return false;
+    }
 
-    // Check if there are words available for the chosen difficulty
-    if (filteredCount == 0)
+    // Store and index them, saving the indexes for next time
+    appendWords(snapshot.words, newWords);
+    buildDictionaryIndex(snapshot.index, snapshot.words);
+    if (hashed)
     {
-        // Display message if no matching words are found
-        cout << "No words available for the selected difficulty level.\n";
+        writeIndexImage(indexImageFile, checksum, snapshot.index, snapshot.words);
+    }
+    return true;
+}
 
-        // Breaks out of this if statement
+// Function to free a snapshot and the files its indexes map
+void freeSnapshot(DictionarySnapshot *snapshot)
+{
+    if (snapshot == nullptr)
+    {
         return;
     }
+    unmapFile(snapshot->index.frequencies);
+    for (WordleTable &table : snapshot->index.wordle)
+    {
+        unmapFile(table.cache);
+    }
+    delete snapshot;
+}
 
-    // Select a random word from the filtered list
-    string word = filteredWords[static_cast<size_t>(rand()) % filteredCount];
-
-    // Scramble the selected word to create an anagram
-    string scrambledWord = scrambleWord(word);
-
-    // Display the unscramble word
-    cout << "Anagram of the word is: " << scrambledWord << endl;
-
-    // Initialize the number of attempts and hints
-    // Total attempts allowed per word
-    int attemptsLeft = 3;
+// Function to rebuild the dictionary each time its file is saved
+// Runs on its own thread for the life of the game. The directory is
+// watched rather than the file, since many editors save by renaming a
+// new file over the old one. Each rebuild is published through
+// pendingSnapshot; one the game never picked up is simply replaced.
+// previous holds the words of the last build, the ones the next build
+// maps to new IDs
+void watchDictionary(const string &filename, WordStore previous)
+{
+#ifdef UNSCRAMBLE_INOTIFY
+    size_t slash = filename.rfind('/');
+    string directory = slash == string::npos ? "." : filename.substr(0, slash);
+    string name = slash == string::npos ? filename : filename.substr(slash + 1);
+    int fd = inotify_init1(IN_CLOEXEC);
+    if (fd < 0)
+    {
+        return;
+    }
+    if (inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+    {
+        close(fd);
+        return;
+    }
 
-    // Number of hints available per word
-    // Track the number of hints used
-    int hintsUsed = 0;
+    alignas(inotify_event) char buffer[4096];
+    uint64_t generation = 0;
+    while (true)
+    {
+        // Wait for events naming the file
+        ssize_t length = read(fd, buffer, sizeof(buffer));
+        if (length <= 0)
+        {
+            break;
+        }
+        bool changed = false;
+        for (ssize_t offset = 0; offset < length;)
+        {
+            const inotify_event *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+            changed = changed || (event->len > 0 && name == event->name);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        }
+        if (!changed)
+        {
+            continue;
+        }
 
-    // Variable to store player's guess
-    string guess;
+        // Let a burst of saves settle, then rebuild and publish
+        this_thread::sleep_for(chrono::milliseconds(reloadSettleMs));
+        DictionarySnapshot *snapshot = new DictionarySnapshot();
+        if (!buildSnapshot(filename, previous, *snapshot))
+        {
+            freeSnapshot(snapshot);
+            continue;
+        }
+        snapshot->baseGeneration = generation;
+        snapshot->generation = ++generation;
+        previous = snapshot->words;
+        freeSnapshot(pendingSnapshot.exchange(snapshot, memory_order_acq_rel));
+    }
+    close(fd);
+#else
+    // No change notifications here; the dictionary loads once
+    static_cast<void>(filename);
+    static_cast<void>(previous);
+#endif
+}
 
-    // Track if the word was guessed correctly
-    bool wordGuessed = false;
+// Function to start watching the dictionary file in the background
+// The watcher takes its own copy of the loaded words to map from
+void startDictionaryWatch(const string &filename, const WordStore &words)
+{
+    thread(watchDictionary, filename, words).detach();
+}
 
-    // Main loop for guessing attempts
-    while (attemptsLeft > 0 && !wordGuessed)
+// Function to switch the game to a newer dictionary, if one is waiting
+// Called between rounds, so a round in progress always finishes on the
+// dictionary it started with. Guesses never wait: the game thread is
+// the only reader of the live indexes and takes the new version with
+// one atomic exchange. It is past every use of the old version when it
+// swaps, so the old one is freed on the spot. Owned packs, ratings,
+// adaptive weights and reviews carry over to the new word IDs, which
+// the watcher has already found for the file's own words; words no
+// longer in the file drop out of the reviews
+bool adoptSnapshot(WordStore &words)
+{
+    DictionarySnapshot *next = pendingSnapshot.exchange(nullptr, memory_order_acq_rel);
+    if (next == nullptr)
     {
-        // Prompt the player for a guess
-        cout << "Guess the word (or type 'hint' for a hint): ";
-        cin >> guess;
+        return false;
+    }
 
-        // Check if the player requested a hint
-        if (guess == "hint")
+    // Swap the new words and indexes in; next now holds the old ones
+    swap(words, next->words);
+    swap(dictionaryIndex, next->index);
+    dictionaryIndex.words = &words;
+    next->index.words = &next->words;
+    const WordStore &oldWords = next->words;
+    size_t oldCount = wordStoreSize(oldWords);
+
+    // Merge the owned packs back in from the old store
+    vector<float> oldRatings;
+    for (const atomic<float> &rating : wordRatings)
+    {
+        oldRatings.push_back(rating.load(memory_order_relaxed));
+    }
+    vector<atomic<float>>().swap(wordRatings);
+    vector<WordPack> packs;
+    packs.swap(loadedPacks);
+    for (const WordPack &pack : packs)
+    {
+        vector<string> packWords;
+        for (uint32_t i = pack.firstId; i < pack.firstId + pack.wordCount && i < oldCount; i++)
         {
-            // Provide a hint and continue the loop without using an attempt
-            useHint(word, hintsUsed, score);
+            packWords.push_back(wordAt(oldWords, i));
+        }
+        vector<uint32_t> distinct;
+        distinctPackWords(packWords, distinct);
+        mergePack(pack.filename, pack.contentHash, packWords, distinct, words);
+    }
+    syncWordRatings(words);
+
+    // Old ID to new ID. The watcher mapped the words it built the last
+    // snapshot from; pack words, and every word when the game skipped a
+    // snapshot, are looked up here by spelling
+    bool mapped = next->baseGeneration == dictionaryGeneration;
+    size_t mappedCount = mapped ? min(next->newIds.size(), oldCount) : 0;
+    vector<uint32_t> newIds(oldCount);
+    copy(next->newIds.begin(), next->newIds.begin() + mappedCount, newIds.begin());
+    for (size_t i = mappedCount; i < oldCount; i++)
+    {
+        newIds[i] = findWordId(wordAt(oldWords, static_cast<uint32_t>(i)));
+    }
+    dictionaryGeneration = next->generation;
 
-            // Continues the flow of code
+    // Ratings and adaptive weights follow their words; the Fenwick tree
+    // is rebuilt on next use
+    vector<float> weights(wordStoreSize(words), 1.0f);
+    for (size_t i = 0; i < oldCount; i++)
+    {
+        if (newIds[i] == noWordId)
+        {
             continue;
         }
+        if (i < oldRatings.size())
+        {
+            wordRatings[newIds[i]].store(oldRatings[i], memory_order_relaxed);
+        }
+        if (i < player.weights.size())
+        {
+            weights[newIds[i]] = player.weights[i];
+        }
+    }
+    player.weights.swap(weights);
+    player.tree.clear();
+
+    // Reschedule the reviews under their new IDs
+    vector<ReviewItem> reviews;
+    reviews.swap(player.reviews);
+    player.reviewSlots.clear();
+    for (ReviewItem item : reviews)
+    {
+        if (item.wordId < oldCount && newIds[item.wordId] != noWordId)
+        {
+            item.wordId = newIds[item.wordId];
+            player.reviews.push_back(item);
+            placeReview(player, player.reviews.size() - 1, item);
+            siftReview(player, player.reviews.size() - 1);
+        }
+    }
 
-        // Check if the player's guess is correct
-        if (guess == word)
+    freeSnapshot(next);
+    return true;
+}
+
+// Function to checksum a block of bytes
+// Four lanes take 8-byte words in turn so their multiplies overlap,
+// which keeps up with reading a large dictionary from the page cache
+uint64_t checksumBytes(const uint8_t *data, size_t size)
+{
+    uint64_t lanes[4] = {0x243f6a8885a308d3ULL, 0x13198a2e03707344ULL, 0xa4093822299f31d0ULL, 0x082efa98ec4e6c89ULL};
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        for (size_t lane = 0; lane < 4; lane++)
         {
-            // Calculate points based on word length and combo streak
-            int points = static_cast<int>(word.length());
+            uint64_t chunk = 0;
+            memcpy(&chunk, data + i + lane * 8, sizeof(chunk));
+            lanes[lane] = (lanes[lane] ^ chunk) * 0x9e3779b97f4a7c15ULL;
+            lanes[lane] = (lanes[lane] << 31) | (lanes[lane] >> 33);
+        }
+    }
 
-            // Example: 2 extra points per streak level
-            int comboBonus = streak * 2;
+    // Trailing bytes go into the first lane one at a time
+    for (; i < size; i++)
+    {
+        lanes[0] = (lanes[0] ^ data[i]) * 0x100000001b3ULL;
+    }
 
-            // Bonus increases points
-            points += comboBonus;
+    // Fold the lanes and the length together
+    uint64_t checksum = size;
+    for (size_t lane = 0; lane < 4; lane++)
+    {
+        checksum = mixHash(checksum ^ lanes[lane], lane + 1);
+    }
+    return checksum;
+}
 
-            // Increment the streak and update max streak if new streak is higher
-            streak++;
+// Function to checksum a whole file
+bool fileChecksum(const string &filename, uint64_t &checksum)
+{
+    MappedFile file;
+    if (!mapFile(file, filename))
+    {
+        return false;
+    }
+    checksum = checksumBytes(file.data, file.size);
+    unmapFile(file);
+    return true;
+}
 
-            // Increase max streak value
-            if (streak > maxStreak)
-            {
-                // Maxstreak takes value of streak
-                maxStreak = streak;
-            }
+// Function to key an index image to the code that built it
+// Folds in the image version, the constants the indexes are sized by,
+// and sample outputs of the hashes that place words in them, so an
+// image written by a build with other settings is rebuilt, not misread
+uint64_t indexBuildKey()
+{
+    uint64_t rate = 0;
+    uint64_t gamma = 0;
+    memcpy(&rate, &bloomFalsePositiveRate, sizeof(rate));
+    memcpy(&gamma, &perfectHashGamma, sizeof(gamma));
+    const uint64_t parts[] = {indexImageVersion, sizeof(IndexImageHeader), sizeof(LetterHistogram), noWordId,
+                              rate, bloomBlockBits, gamma, rankBlockBits,
+                              patternMaxLength, hangmanMaxLength, gridCells, gridMinWordLength,
+                              static_cast<uint64_t>(beeLetters), beeMinWordLength,
+                              hashWord("unscramble"), mixHash(indexImageMagic, 1), ladderBucketKey("ladder", 2)};
+    uint64_t key = 0;
+    for (size_t i = 0; i < sizeof(parts) / sizeof(parts[0]); i++)
+    {
+        key = mixHash(key ^ parts[i], i + 1);
+    }
+    return key;
+}
 
-            // Display points earned, including combo points
-            cout << "Correct! You earned " << points << " points (including " << comboBonus << " combo points)!\n";
-            cout << "Current streak: " << streak << " | Max streak: " << maxStreak << endl;
+// Function to checksum a whole index image
+// Folds the header, with its imageChecksum zeroed, into the section
+// checksums the cursor gathered and the section table
+uint64_t imageChecksum(IndexImageHeader header, const IndexImageCursor &cursor)
+{
+    header.imageChecksum = 0;
+    uint64_t checksum = cursor.checksum ^ checksumBytes(reinterpret_cast<const uint8_t *>(&header), sizeof(header));
+    checksum = mixHash(checksum, checksumBytes(reinterpret_cast<const uint8_t *>(cursor.sections.data()),
+                                               cursor.sections.size() * sizeof(IndexImageSection)));
+    return checksum;
+}
 
-            // Update the score with points and end the round
-            updateScore(true, score, highestScore, points);
-            wordGuessed = true;
+// Function to write or read the next section of an index image
+// Writing pads the file to the image alignment and appends count
+// elements from data. Reading returns the section's first byte and its
+// element count in readCount, or nullptr once the image is found bad
+const uint8_t *imageSpan(IndexImageCursor &cursor, const void *data, size_t count, size_t elementSize, size_t &readCount)
+{
+    readCount = 0;
+    if (cursor.writing)
+    {
+        static const char zeros[indexImageAlign] = {};
+        size_t padding = static_cast<size_t>((indexImageAlign - cursor.offset % indexImageAlign) % indexImageAlign);
+        cursor.out->write(zeros, static_cast<streamsize>(padding));
+        cursor.offset += padding;
+        IndexImageSection section = {cursor.offset, count * elementSize};
+        cursor.out->write(static_cast<const char *>(data), static_cast<streamsize>(section.bytes));
+        cursor.offset += section.bytes;
+        cursor.sections.push_back(section);
+        cursor.checksum = mixHash(cursor.checksum ^ checksumBytes(static_cast<const uint8_t *>(data), section.bytes), cursor.sections.size());
+        return nullptr;
+    }
+
+    // Check the section is in the table, inside the file, and a whole
+    // number of elements
+    if (!cursor.ok || cursor.next >= cursor.sections.size())
+    {
+        cursor.ok = false;
+        return nullptr;
+    }
+    const IndexImageSection &section = cursor.sections[cursor.next++];
+    if (section.offset > cursor.size || section.bytes > cursor.size - section.offset || section.bytes % elementSize != 0)
+    {
+        cursor.ok = false;
+        return nullptr;
+    }
+    readCount = static_cast<size_t>(section.bytes / elementSize);
+    cursor.checksum = mixHash(cursor.checksum ^ checksumBytes(cursor.data + section.offset, section.bytes), cursor.next);
+    return cursor.data + section.offset;
+}
+
+// Functions to write or read one index array
+// Reading copies the section into the vector with a single memcpy
+void imageArray(IndexImageCursor &cursor, vector<uint64_t> &values)
+{
+    size_t count = 0;
+    const uint8_t *bytes = imageSpan(cursor, values.data(), values.size(), sizeof(uint64_t), count);
+    if (!cursor.writing)
+    {
+        values.resize(count);
+        if (count > 0)
+        {
+            memcpy(values.data(), bytes, count * sizeof(uint64_t));
         }
-        else
+    }
+}
+
+void imageArray(IndexImageCursor &cursor, vector<uint32_t> &values)
+{
+    size_t count = 0;
+    const uint8_t *bytes = imageSpan(cursor, values.data(), values.size(), sizeof(uint32_t), count);
+    if (!cursor.writing)
+    {
+        values.resize(count);
+        if (count > 0)
+        {
+            memcpy(values.data(), bytes, count * sizeof(uint32_t));
+        }
+    }
+}
+
+void imageArray(IndexImageCursor &cursor, vector<uint8_t> &values)
+{
+    size_t count = 0;
+    const uint8_t *bytes = imageSpan(cursor, values.data(), values.size(), sizeof(uint8_t), count);
+    if (!cursor.writing)
+    {
+        values.resize(count);
+        if (count > 0)
         {
-            // Deduct an attempt if the guess was incorrect
-            attemptsLeft--;
-            cout << "Incorrect guess. Attempts left: " << attemptsLeft << endl;
+            memcpy(values.data(), bytes, count);
+        }
+    }
+}
 
-            // Reset the streak since the guess was incorrect
-            streak = 0;
+void imageArray(IndexImageCursor &cursor, vector<LetterHistogram> &values)
+{
+    size_t count = 0;
+    const uint8_t *bytes = imageSpan(cursor, values.data(), values.size(), sizeof(LetterHistogram), count);
+    if (!cursor.writing)
+    {
+        values.resize(count);
+        if (count > 0)
+        {
+            memcpy(values.data(), bytes, count * sizeof(LetterHistogram));
         }
     }
+}
 
-    // If the player didn't guess the word correctly, handle game over
-    if (!wordGuessed)
+void imageArray(IndexImageCursor &cursor, string &values)
+{
+    size_t count = 0;
+    const uint8_t *bytes = imageSpan(cursor, values.data(), values.size(), sizeof(char), count);
+    if (!cursor.writing)
     {
-        handleGameOver(score, word);
+        values.assign(reinterpret_cast<const char *>(bytes), count);
     }
+}
 
-    // Prompt the user to press Enter to continue
-    cout << "Press \"Enter\" to continue.\n";
-    cin.ignore();
-    cin.get();
+// Function to walk every array of an index image in its fixed order
+// The writer and the reader both go through here, so the two can never
+// disagree on the layout
+void visitIndexImage(IndexImageCursor &cursor, DictionaryIndex &index, WordStore &words, string &letters)
+{
+    // Words: lengths, then all letters back to back
+    imageArray(cursor, words.lengths);
+    imageArray(cursor, letters);
+
+    // Guess checking
+    imageArray(cursor, index.bloom.bits);
+    imageArray(cursor, index.wordHash.bits);
+    imageArray(cursor, index.wordHash.levelOffsets);
+    imageArray(cursor, index.wordHash.rankSamples);
+    imageArray(cursor, index.slotToId);
+    imageArray(cursor, index.collidingIds);
+    imageArray(cursor, index.histograms);
+    imageArray(cursor, index.letterMasks);
+    imageArray(cursor, index.byLength);
+    imageArray(cursor, index.lengthRank);
+    imageArray(cursor, index.lengthStarts);
+
+    // Game modes
+    imageArray(cursor, index.ladder.keys);
+    imageArray(cursor, index.ladder.starts);
+    imageArray(cursor, index.ladder.wordIds);
+    imageArray(cursor, index.gridTrie.childMasks);
+    imageArray(cursor, index.gridTrie.firstChild);
+    imageArray(cursor, index.gridTrie.wordIds);
+    imageArray(cursor, index.bee.masks);
+    imageArray(cursor, index.bee.starts);
+    imageArray(cursor, index.bee.wordIds);
+    for (PatternBucket &bucket : index.patterns)
+    {
+        imageArray(cursor, bucket.wordIds);
+        imageArray(cursor, bucket.bits);
+    }
+    for (HangmanBucket &bucket : index.hangman)
+    {
+        imageArray(cursor, bucket.wordIds);
+        imageArray(cursor, bucket.letters);
+    }
 }
 
-// Function to display shop and offer more words
-void displayShop(array<string, maxWords> &words, size_t &wordCount)
+// Function to check word IDs read from an image are all below
+// wordCount, or noWordId where the index allows an empty entry
+bool idsInRange(const vector<uint32_t> &wordIds, size_t wordCount, bool noneAllowed)
 {
-    // Display shop menu options
-    cout << "Welcome to the shop.\n";
-    cout << "1. Load more difficult words\n";
-    cout << "2. Exit shop\n";
-    cout << "Enter your choice: ";
+    for (uint32_t wordId : wordIds)
+    {
+        if (wordId >= wordCount && !(noneAllowed && wordId == noWordId))
+        {
+            return false;
+        }
+    }
+    return true;
+}
 
-    // Get user's choice
-    int shopOption;
+// Function to check group starts read from an image: one per group
+// plus an end marker, never decreasing, ending at the entry count
+bool groupsInRange(const vector<uint32_t> &starts, size_t groups, size_t entries)
+{
+    if (starts.size() != groups + 1 || starts.back() != entries)
+    {
+        return false;
+    }
+    for (size_t i = 1; i < starts.size(); i++)
+    {
+        if (starts[i] < starts[i - 1])
+        {
+            return false;
+        }
+    }
+    return true;
+}
 
-    // User input an option
-    cin >> shopOption;
+// Function to check the arrays read from an image fit together
+// The image checksum catches damage; this catches an image that is
+// whole but wrong, so no lookup can index past an array
+bool indexImageConsistent(const DictionaryIndex &index, const IndexImageHeader &header)
+{
+    size_t wordCount = static_cast<size_t>(header.wordCount);
 
-    // Check if user chose to load more words
-    if (shopOption == 1)
+    // Bloom filter
+    if (index.bloom.bits.size() != header.bloomBlocks * (bloomBlockBits / 64) || header.bloomBlocks == 0 ||
+        header.bloomProbes == 0 || header.bloomProbes > bloomBlockBits)
     {
-        // Load words from an additional file
-        size_t newWords = loadWords("dictionary2.txt", words, wordCount);
+        return false;
+    }
 
-        // Update word count with new words added
-        wordCount += newWords;
+    // Perfect hash: levels of whole rank blocks that cover the bits
+    // exactly, rank samples that match them, one word per slot
+    const PerfectHash &hash = index.wordHash;
+    if (hash.levelOffsets.empty() || hash.levelOffsets.front() != 0 || hash.levelOffsets.back() != hash.bits.size() * 64)
+    {
+        return false;
+    }
+    for (size_t level = 1; level < hash.levelOffsets.size(); level++)
+    {
+        uint64_t levelBits = hash.levelOffsets[level] - hash.levelOffsets[level - 1];
+        if (hash.levelOffsets[level] <= hash.levelOffsets[level - 1] || levelBits % rankBlockBits != 0)
+        {
+            return false;
+        }
+    }
+    vector<uint32_t> samples;
+    buildRankSamples(hash.bits, samples);
+    if (samples != hash.rankSamples || samples.back() != header.hashKeys || index.slotToId.size() != header.hashKeys ||
+        !idsInRange(index.slotToId, wordCount, true) || !idsInRange(index.collidingIds, wordCount, false))
+    {
+        return false;
+    }
 
-        // Display number of new words added
-        cout << newWords << " new words added!\n";
+    // Per-word arrays and the length order
+    if (index.histograms.size() != wordCount || index.letterMasks.size() != wordCount ||
+        index.byLength.size() != wordCount || index.lengthRank.size() != wordCount ||
+        !idsInRange(index.byLength, wordCount, false) || !groupsInRange(index.lengthStarts, 256, wordCount))
+    {
+        return false;
     }
-    else
+    for (uint32_t rank : index.lengthRank)
     {
-        // Exit the shop if the user chose to
-        cout << "Exiting the shop.\n";
+        if (rank >= wordCount)
+        {
+            return false;
+        }
     }
 
-    // Prompt user to press Enter to continue
-    cout << "Press \"Enter\" to continue.\n";
-    cin.ignore();
-    cin.get();
+    // Ladder and spelling bee groups
+    if (!groupsInRange(index.ladder.starts, index.ladder.keys.size(), index.ladder.wordIds.size()) ||
+        !idsInRange(index.ladder.wordIds, wordCount, false) ||
+        !groupsInRange(index.bee.starts, index.bee.masks.size(), index.bee.wordIds.size()) ||
+        !idsInRange(index.bee.wordIds, wordCount, false))
+    {
+        return false;
+    }
+
+    // Grid trie: a root, and every node's children inside the trie
+    const GridTrie &trie = index.gridTrie;
+    size_t nodes = trie.childMasks.size();
+    if (nodes == 0 || trie.firstChild.size() != nodes || trie.wordIds.size() != nodes || !idsInRange(trie.wordIds, wordCount, true))
+    {
+        return false;
+    }
+    for (size_t node = 0; node < nodes; node++)
+    {
+        if (trie.childMasks[node] >> 26 != 0 ||
+            trie.firstChild[node] + static_cast<size_t>(__builtin_popcount(trie.childMasks[node])) > nodes)
+        {
+            return false;
+        }
+    }
+
+    // Pattern and hangman buckets
+    for (size_t length = 0; length <= patternMaxLength; length++)
+    {
+        const PatternBucket &bucket = index.patterns[length];
+        if (header.patternBlocks[length] != (bucket.wordIds.size() + 63) / 64 ||
+            bucket.bits.size() != length * 26 * header.patternBlocks[length] || !idsInRange(bucket.wordIds, wordCount, false))
+        {
+            return false;
+        }
+    }
+    for (const HangmanBucket &bucket : index.hangman)
+    {
+        if (bucket.letters.size() != bucket.wordIds.size() * 2 || !idsInRange(bucket.wordIds, wordCount, false))
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
-// Function to load words from a file into a fixed-size array
-size_t loadWords(const string &filename, array<string, maxWords> &words, size_t startIndex)
+// Function to save the indexes built from a dictionary as an image
+// Written under a temporary name and renamed into place, so a reader
+// never sees half a file
+bool writeIndexImage(const string &filename, uint64_t checksum, DictionaryIndex &index, WordStore &words)
 {
-    // Open the file
-    ifstream file(filename);
+    if (words.backend != WordBackend::Strings)
+    {
+        return false;
+    }
+    string temporary = filename + ".tmp";
+    ofstream out(temporary, ios::binary);
+    saveIndexImage(out, checksum, index, words);
+    out.close();
+    if (!out)
+    {
+        remove(temporary.c_str());
+        return false;
+    }
+    return rename(temporary.c_str(), filename.c_str()) == 0;
+}
 
-    // Start counting from the given index
-    size_t count = startIndex;
+// Function to write the image of a dictionary's indexes to a stream
+// (Strings backend)
+void saveIndexImage(ostream &out, uint64_t checksum, DictionaryIndex &index, WordStore &words)
+{
+    string letters;
+    for (const string &word : words.strings)
+    {
+        letters += word;
+    }
 
-    // Read words from the file until reaching maxWords
-    while (file >> words[count] && count < maxWords)
+    // Room for the header, then the sections
+    IndexImageHeader header = {};
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    IndexImageCursor cursor;
+    cursor.writing = true;
+    cursor.out = &out;
+    cursor.offset = sizeof(header);
+    visitIndexImage(cursor, index, words, letters);
+
+    // Section table, then the header filled in and checksummed
+    header.magic = indexImageMagic;
+    header.version = indexImageVersion;
+    header.sectionCount = static_cast<uint32_t>(cursor.sections.size());
+    header.checksum = checksum;
+    header.buildKey = indexBuildKey();
+    header.wordCount = wordStoreSize(words);
+    header.tableOffset = cursor.offset;
+    header.bloomBlocks = index.bloom.blockCount;
+    header.bloomCapacity = index.bloom.capacity;
+    header.bloomProbes = static_cast<uint32_t>(index.bloom.probes);
+    header.hashKeys = index.wordHash.keyCount;
+    for (size_t length = 0; length <= patternMaxLength; length++)
     {
-        // Count is incremented by 1
-        count++;
+        header.patternBlocks[length] = index.patterns[length].blocks;
     }
+    header.imageChecksum = imageChecksum(header, cursor);
+    out.write(reinterpret_cast<const char *>(cursor.sections.data()),
+              static_cast<streamsize>(cursor.sections.size() * sizeof(IndexImageSection)));
+    out.seekp(0);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.seekp(0, ios::end);
+}
 
-    // Return the number of words loaded
-    return count - startIndex;
+// Function to load a dictionary's words and indexes from its image
+// The image is mapped read-only and each array is copied out whole, as
+// packs and reloads change the indexes after loading. Returns false,
+// leaving the store empty, when the image is missing, damaged, was
+// built from other words or was written by a build with other settings
+bool readIndexImage(const string &filename, uint64_t checksum, DictionaryIndex &index, WordStore &words)
+{
+    MappedFile image;
+    if (!mapFile(image, filename))
+    {
+        return false;
+    }
+    bool loaded = copyIndexImage(image.data, image.size, checksum, index, words);
+    unmapFile(image);
+    if (loaded)
+    {
+        loadFrequencyTable(index, words.strings, frequencyFile);
+    }
+    return loaded;
 }
 
-// Function to scramble a word to create an anagram
-string scrambleWord(const string &word)
+// Function to copy a dictionary's words and indexes out of an image in
+// memory, mapped from a file or compiled into the program. The caller
+// attaches the frequency table that goes with it
+bool copyIndexImage(const uint8_t *data, size_t size, uint64_t checksum, DictionaryIndex &index, WordStore &words)
 {
-    // Copy the original word to scramble
-    string anagram = word;
+    // Check the image belongs to this dictionary and this build
+    IndexImageHeader header = {};
+    if (size >= sizeof(header))
+    {
+        memcpy(&header, data, sizeof(header));
+    }
+    if (header.magic != indexImageMagic || header.version != indexImageVersion || header.checksum != checksum ||
+        header.buildKey != indexBuildKey() || header.tableOffset < sizeof(header) || header.tableOffset > size ||
+        header.sectionCount > (size - header.tableOffset) / sizeof(IndexImageSection))
+    {
+        return false;
+    }
 
-    // Loop through each character in the word
-    for (size_t j = 0; j < word.length(); j++)
+    // Copy every array out
+    IndexImageCursor cursor;
+    cursor.data = data;
+    cursor.size = size;
+    cursor.sections.resize(header.sectionCount);
+    memcpy(cursor.sections.data(), data + header.tableOffset, header.sectionCount * sizeof(IndexImageSection));
+    string letters;
+    visitIndexImage(cursor, index, words, letters);
+
+    // Every section used and undamaged, the lengths spell out the
+    // letters exactly, and every array fits the others
+    size_t letterCount = 0;
+    for (uint8_t length : words.lengths)
+    {
+        letterCount += length;
+    }
+    if (!cursor.ok || cursor.next != cursor.sections.size() || imageChecksum(header, cursor) != header.imageChecksum ||
+        words.lengths.size() != header.wordCount || letterCount != letters.size() || !indexImageConsistent(index, header))
     {
-        // Generate a random index
-        size_t k = static_cast<size_t>(rand()) % word.length();
+        words.lengths.clear();
+        return false;
+    }
 
-        // Swap characters to scramble
-        swap(anagram[j], anagram[k]);
+    // Spell the words back out
+    words.strings.resize(words.lengths.size());
+    size_t start = 0;
+    for (size_t i = 0; i < words.lengths.size(); i++)
+    {
+        words.strings[i].assign(letters, start, words.lengths[i]);
+        start += words.lengths[i];
     }
 
-    // Return the scrambled word
-    return anagram;
+    // Sizes kept in the header, and the parts built on use
+    index.bloom.blockCount = static_cast<size_t>(header.bloomBlocks);
+    index.bloom.capacity = static_cast<size_t>(header.bloomCapacity);
+    index.bloom.probes = static_cast<int>(header.bloomProbes);
+    index.wordHash.keyCount = static_cast<size_t>(header.hashKeys);
+    for (size_t length = 0; length <= patternMaxLength; length++)
+    {
+        index.patterns[length].blocks = static_cast<size_t>(header.patternBlocks[length]);
+    }
+    index.overflowIds.clear();
+    for (uint32_t wordId : index.collidingIds)
+    {
+        index.overflowIds.emplace(words.strings[wordId], wordId);
+    }
+    for (WordleTable &table : index.wordle)
+    {
+        unmapFile(table.cache);
+        table = WordleTable();
+    }
+    index.modesStale = false;
+    index.words = &words;
+    return true;
 }
 
-// Function to handle game over scenario
-void handleGameOver(int &score, const string &correctWord)
+// Function to load a dictionary and build its lookup indexes
+// When the file's checksum matches the saved image the indexes are
+// copied out of it, which is linear in the image size but skips every
+// sort and hash of a build; otherwise the words are read and linted, the indexes
+// built, and the image saved for the next start. Returns the number of
+// words loaded
+size_t loadDictionary(const string &filename, WordStore &words, DictionaryIndex &index)
 {
-    // Display the correct answer
-    cout << "Game Over! The correct answer was \"" << correctWord << "\"\n";
+    // Try the saved image first
+    uint64_t checksum = 0;
+    bool hashed = words.backend == WordBackend::Strings && wordStoreSize(words) == 0 && fileChecksum(filename, checksum);
+    if (hashed && readIndexImage(indexImageFile, checksum, index, words))
+    {
+        return wordStoreSize(words);
+    }
 
-    // Reset the score to zero
-    score = 0;
+    // Build from the words and save the result
+    size_t loaded = loadWords(filename, words);
+    buildDictionaryIndex(index, words);
+    if (hashed)
+    {
+        writeIndexImage(indexImageFile, checksum, index, words);
+    }
+    return loaded;
 }
 
-// Function to update score and track highest score
-void updateScore(bool isCorrect, int &score, int &highestScore, int points)
+// Function to load the default dictionary
+// A build with default_dictionary.h copies its words, indexes and
+// frequency table out of the program itself, so neither dictionary.txt
+// nor dictionary.freq is read; other builds load dictionary.txt as
+// usual. A header made by a build with other index settings is refused
+// with a message rather than misread. Returns the number of words loaded
+size_t loadDefaultDictionary(WordStore &words, DictionaryIndex &index)
 {
-    // If the answer is correct
-    if (isCorrect)
+#ifdef UNSCRAMBLE_EMBEDDED_DICTIONARY
+    // Copy the compiled-in words and indexes, then point the frequency
+    // table at the compiled-in one
+    if (words.backend == WordBackend::Strings && wordStoreSize(words) == 0)
     {
-        // Add points based on word length
-        score += points;
-
-        // Update highest score if needed
-        if (score > highestScore)
+        if (embeddedBuildKey != indexBuildKey())
         {
-            // Highest Score will equal the current score
-            highestScore = score;
+            cout << "default_dictionary.h was made with other index settings; run --embed again. Using dictionary.txt.\n";
+        }
+        else if (copyIndexImage(reinterpret_cast<const uint8_t *>(embeddedImage), embeddedImageBytes, embeddedDictionaryChecksum, index, words))
+        {
+            unmapFile(index.frequencies);
+            index.frequencies.data = reinterpret_cast<const uint8_t *>(embeddedFrequencies);
+            index.frequencies.size = embeddedFrequencyBytes;
+            useFrequencyTable(index, words.strings);
+            return wordStoreSize(words);
+        }
+        else
+        {
+            cout << "default_dictionary.h is damaged; run --embed again. Using dictionary.txt.\n";
         }
     }
-    else
+#endif
+    return loadDictionary("dictionary.txt", words, index);
+}
+
+// Function to generate the header that compiles a dictionary into the
+// program. The words are indexed here, at build time, and the header
+// holds the finished index image (length buckets, perfect hash and the
+// rest) and the dictionary's frequency table, if it has a matching one,
+// as constexpr byte strings, so the game starts by copying them
+bool embedDictionary(const string &dictionaryFile, const string &headerFile)
+{
+    // Index the words as the game would
+    uint64_t checksum = 0;
+    WordStore words;
+    words.backend = WordBackend::Strings;
+    if (!fileChecksum(dictionaryFile, checksum) || loadWords(dictionaryFile, words) == 0)
     {
-        // Deduct one point for incorrect answer
-        score--;
+        cout << "No words in " << dictionaryFile << ".\n";
+        return false;
+    }
+    DictionaryIndex index;
+    buildDictionaryIndex(index, words);
+    loadFrequencyTable(index, words.strings, frequencyFileFor(dictionaryFile));
+    ostringstream image;
+    saveIndexImage(image, checksum, index, words);
+    string bytes = image.str();
+    size_t frequencyBytes = index.frequencyCount > 0 ? index.frequencies.size : 0;
+
+    // Write the image and the frequency table as string literals, keyed
+    // to the index settings of this build
+    ofstream out(headerFile);
+    out << "// Generated by cis17c_project1 --embed " << dictionaryFile << "; do not edit\n";
+    out << "// " << wordStoreSize(words) << " words, index image of " << bytes.size() << " bytes, frequency table of "
+        << frequencyBytes << " bytes\n";
+    out << "const uint64_t embeddedDictionaryChecksum = " << checksum << "ULL;\n";
+    out << "const uint64_t embeddedBuildKey = " << indexBuildKey() << "ULL;\n";
+    out << "const size_t embeddedImageBytes = " << bytes.size() << ";\n";
+    out << "alignas(64) constexpr char embeddedImage[] =\n";
+    writeByteLiteral(out, reinterpret_cast<const uint8_t *>(bytes.data()), bytes.size());
+    out << "const size_t embeddedFrequencyBytes = " << frequencyBytes << ";\n";
+    out << "alignas(64) constexpr char embeddedFrequencies[] =\n";
+    writeByteLiteral(out, index.frequencies.data, frequencyBytes);
+    unmapFile(index.frequencies);
+    if (!out)
+    {
+        cout << "Could not write " << headerFile << ".\n";
+        return false;
     }
+    cout << "Wrote " << wordStoreSize(words) << " words (" << bytes.size() << " bytes of indexes, " << frequencyBytes
+         << " bytes of frequencies) to " << headerFile << ". Rebuild to compile them in.\n";
+    return true;
 }
 
-// Function to display all achievements and their status
-void displayAchievements()
+// Function to write bytes as a string literal ending a declaration
+// Bytes that are not plain text become three-digit octal escapes,
+// which can't run into the character after them
+void writeByteLiteral(ostream &out, const uint8_t *data, size_t size)
 {
-    // Print achievement header
-    cout << "\nAchievements:\n";
-
-    // Loop through each achievement
-    for (const auto &achievement : achievements)
+    out << "    \"";
+    size_t column = 0;
+    for (size_t i = 0; i < size; i++)
     {
-        // Display achievement name
-        cout << "- " << achievement.name << ": ";
-
-        // Display status if achieved
-        if (achievement.achieved)
+        char c = static_cast<char>(data[i]);
+        if (c >= ' ' && c <= '~' && c != '"' && c != '\\' && c != '?')
         {
-            cout << "Achieved! ";
+            out << c;
+            column++;
+        }
+        else
+        {
+            uint8_t byte = static_cast<uint8_t>(c);
+            out << '\\' << static_cast<char>('0' + (byte >> 6)) << static_cast<char>('0' + ((byte >> 3) & 7))
+                << static_cast<char>('0' + (byte & 7));
+            column += 4;
+        }
+        if (column >= 96)
+        {
+            out << "\"\n    \"";
+            column = 0;
         }
-
-        // Display achievement description
-        cout << "(" << achievement.description << ")\n";
     }
-
-    // Add extra line for spacing
-    cout << endl;
+    out << "\";\n";
 }
 
-// Function to check and update achievements based on game progress
-// Function do not award player
-void updateAchievements(bool wonGame, int score, int hintsUsed, int timeTaken)
+// Function to make a Word from letters
+// Short words are copied inline; longer ones are appended to wordArena,
+// with their offset and full length kept in the inline bytes
+Word makeWord(const char *letters, size_t length)
 {
-    // Check if "First Win" achievement is earned
-    if (wonGame && !achievements[0].achieved)
+    Word word = {};
+    word.length = static_cast<uint8_t>(min<size_t>(length, 255));
+    if (length <= wordInlineLetters)
     {
-        // Achievement 1
-        achievements[0].achieved = true;
-
-        // Prompt User that achievement is earned
-        cout << "Congratulations! You earned the achievement: " << achievements[0].name << "!\n";
+        memcpy(word.letters, letters, length);
+        return word;
     }
+    uint64_t place[2] = {wordArena.size(), length};
+    wordArena.append(letters, length);
+    memcpy(word.letters, place, sizeof(place));
+    word.spilled = 1;
+    return word;
+}
 
-    // Check if "Hint Master" achievement is earned
-    if (wonGame && hintsUsed == 0 && !achievements[1].achieved)
+// Function to get a stored word as a Word
+// The Strings backend hands its letters over without a temporary string
+Word storedWord(const WordStore &words, uint32_t wordId)
+{
+    if (words.backend == WordBackend::Strings)
     {
-        // Achievement 2
-        achievements[1].achieved = true;
-
-        // Prompt User that achievement is earned
-        cout << "Amazing! You earned the achievement: " << achievements[1].name << "!\n";
+        const string &text = words.strings[wordId];
+        return makeWord(text.data(), text.length());
     }
+    string text = wordAt(words, wordId);
+    return makeWord(text.data(), text.length());
+}
 
-    // Check if "High Scorer" achievement is earned
-    if (score >= 50 && !achievements[2].achieved)
+// Function to get the first letter of a Word
+const char *wordLetters(const Word &word)
+{
+    if (!word.spilled)
     {
-        // Achievement 3
-        achievements[2].achieved = true;
-
-        // Prompt User that achievement is earned
-        cout << "Impressive! You earned the achievement: " << achievements[2].name << "!\n";
+        return word.letters;
     }
+    uint64_t offset = 0;
+    memcpy(&offset, word.letters, sizeof(offset));
+    return wordArena.data() + offset;
+}
 
-    // Check if "Quick Thinker" achievement is earned
-    if (wonGame && timeTaken <= 30 && !achievements[3].achieved)
+// Function to view the letters of a Word, for printing and comparing
+string_view wordView(const Word &word)
+{
+    if (!word.spilled)
     {
-        // Achievement 4
-        achievements[3].achieved = true;
-
-        // Prompt User that achievement is earned
-        cout << "Fast thinking! You earned the achievement: " << achievements[3].name << "!\n";
+        return string_view(word.letters, word.length);
     }
+    uint64_t length = 0;
+    memcpy(&length, word.letters + sizeof(uint64_t), sizeof(length));
+    return string_view(wordLetters(word), static_cast<size_t>(length));
 }
 
-// Function to simulate a game round and check achievements
-// This function will run after each played game
-void playGame()
+// Function to check if two Words have the same letters
+// Two inline Words are equal exactly when all 24 bytes are, and the
+// fixed-size compare compiles to a few vector or 8-byte compares
+bool wordsEqual(const Word &a, const Word &b)
 {
-    // Track the player's score
-    int score = 0;
-
-    // Track number of hints used
-    int hintsUsed = 0;
-
-    // Time taken to win the game in seconds
-    int timeTaken = 25;
-
-    // Did the player win the game?
-    bool wonGame = true;
-
-    // Example score increment after winning a game
-    score += 10;
-
-    // Assume no hints were used this round
-    hintsUsed = 0;
+    if (!a.spilled && !b.spilled)
+    {
+        return memcmp(&a, &b, sizeof(Word)) == 0;
+    }
+    return wordView(a) == wordView(b);
+}
 
-    // Check for new achievements
-    updateAchievements(wonGame, score, hintsUsed, timeTaken);
+// Function to count the letters of a Word
+// Inline letters are counted over the whole zero-padded block without a
+// length check per letter, then the padding is taken back out of
+// bucket 26, so the loop has a fixed trip count the compiler unrolls
+LetterHistogram wordHistogram(const Word &word)
+{
+    if (word.spilled)
+    {
+        return computeHistogram(string(wordView(word)));
+    }
+    LetterHistogram histogram = {};
+    for (size_t i = 0; i < wordInlineLetters; i++)
+    {
+        unsigned bucket = static_cast<unsigned>(word.letters[i] - 'a');
+        histogram.counts[bucket < 26 ? bucket : 26]++;
+    }
+    histogram.counts[26] = static_cast<uint8_t>(histogram.counts[26] - (wordInlineLetters - word.length));
+    return histogram;
+}
 
-    // Display all achievements
-    displayAchievements();
+// Function to shuffle a Word's letters in place
+// Each letter is swapped with a random one, as scrambles always were. A
+// long word is first copied to fresh arena letters, so the Word it was
+// copied from keeps its order
+void shuffleWord(Word &word)
+{
+    char *letters = word.letters;
+    size_t length = word.length;
+    if (word.spilled)
+    {
+        string text(wordView(word));
+        word = makeWord(text.data(), text.length());
+        letters = &wordArena[wordArena.size() - text.length()];
+        length = text.length();
+    }
+    for (size_t j = 0; j < length; j++)
+    {
+        size_t k = static_cast<size_t>(rand()) % length;
+        swap(letters[j], letters[k]);
+    }
 }
\ No newline at end of file